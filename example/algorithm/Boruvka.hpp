@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+#include "Kruskal.hpp"
+#include "ThreadPool.hpp"
+#include "../data_structure/disjoint_sets.hpp"
+
+// Boruvka: a parallel minimum-spanning-tree algorithm.
+// Each round, every component picks its lightest outgoing edge, and all picked edges are added at
+// once, which at least halves the number of components. So there are O(logV) rounds, and each
+// round is parallel over the edges left.
+//     Picking: each edge updates the pick of both of its components with an atomic min on
+//     `(weight, edge index)`. Ties are broken by the edge index, so the picked edges never form a
+//     cycle.
+//     Contracting: picked edges are united in `ConcurrentDisjointSets`. An edge picked by both of
+//     its components is added once, since only the first `Unite()` succeeds. Then edges are
+//     relabeled to the roots of their components, and edges inside one component are removed.
+// Same total weight as `Kruskal()`, a minimum spanning forest if the graph is disconnected.
+// Usage: `Boruvka(n, pool).Run(edges, tree)`.
+class Boruvka {
+    static constexpr uint64_t none = ~uint64_t(0);
+
+    struct WorkEdge {
+        int a, b; // Roots of the components of the endpoints.
+        int index; // Index in the input.
+    };
+
+    int n_;
+    ThreadPool &pool_;
+    ConcurrentDisjointSets ds_;
+    vector<atomic<uint64_t>> pick_; // Lightest outgoing `Key()` of each root.
+
+    // Order of edges: by weight, then by index.
+    static uint64_t Key(int d, int index) {
+        return uint64_t(uint32_t(d) ^ 0x80000000u) << 32 | uint32_t(index);
+    }
+
+    static void AtomicMin(atomic<uint64_t> &a, uint64_t value) {
+        uint64_t current = a.load(memory_order_relaxed);
+        while(value < current)
+            if(a.compare_exchange_weak(current, value, memory_order_relaxed))
+                return;
+    }
+
+    // Run `f(i)` for each `i` in [0, n), split into chunks.
+    template<typename F>
+    void ForEachChunk(size_t n, F f) {
+        int n_chunk = min<size_t>((pool_.size() + 1) * 4, (n + 1023) / 1024);
+        pool_.ParallelFor(n_chunk, [&](int c) {
+            for(size_t i = n * c / n_chunk, end = n * (c + 1) / n_chunk; i < end; i++)
+                f(i);
+        });
+    }
+
+public:
+    // Nodes are in [1, n], or [0, n - 1].
+    Boruvka(int n, ThreadPool &pool): n_(n), pool_(pool), ds_(n), pick_(n + 1) {}
+
+    // Return the total weight, and set `tree` to the edges of the minimum spanning forest.
+    int Run(const vector<Edge> &edges, vector<Edge> &tree) {
+        vector<WorkEdge> work;
+        work.reserve(edges.size());
+        for(size_t i = 0; i < edges.size(); i++)
+            if(edges[i].a != edges[i].b)
+                work.push_back({edges[i].a, edges[i].b, int(i)});
+        vector<int> roots(n_ + 1);
+        for(int i = 0; i <= n_; i++)
+            roots[i] = i;
+        tree.clear();
+        vector<vector<Edge>> chunk_tree(pool_.size() + 1);
+
+        while(!work.empty()) {
+            ForEachChunk(roots.size(), [&](size_t i) {
+                pick_[roots[i]].store(none, memory_order_relaxed);
+            });
+            ForEachChunk(work.size(), [&](size_t i) {
+                uint64_t key = Key(edges[work[i].index].d, work[i].index);
+                AtomicMin(pick_[work[i].a], key);
+                AtomicMin(pick_[work[i].b], key);
+            });
+
+            int n_chunk = pool_.size() + 1;
+            pool_.ParallelFor(n_chunk, [&](int c) {
+                size_t begin = roots.size() * c / n_chunk, end = roots.size() * (c + 1) / n_chunk;
+                for(size_t i = begin; i < end; i++) {
+                    uint64_t key = pick_[roots[i]].load(memory_order_relaxed);
+                    if(key == none)
+                        continue;
+                    const Edge &e = edges[uint32_t(key)];
+                    if(ds_.Unite(e.a, e.b))
+                        chunk_tree[c].push_back(e);
+                }
+            });
+            for(auto &t: chunk_tree) {
+                tree.insert(tree.end(), t.begin(), t.end());
+                t.clear();
+            }
+
+            ForEachChunk(work.size(), [&](size_t i) {
+                work[i].a = ds_.Find(work[i].a);
+                work[i].b = ds_.Find(work[i].b);
+            });
+            auto inside = [](const WorkEdge &e) {
+                return e.a == e.b;
+            };
+            work.erase(ParallelRemoveIf(work.begin(), work.end(), inside, pool_), work.end());
+            auto merged = [&](int root) {
+                return ds_.Find(root) != root;
+            };
+            roots.erase(ParallelRemoveIf(roots.begin(), roots.end(), merged, pool_), roots.end());
+        }
+
+        int sum = 0;
+        for(const auto &e: tree)
+            sum += e.d;
+        return sum;
+    }
+};
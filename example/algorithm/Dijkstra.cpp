@@ -1,63 +1,13 @@
 // Dijkstra with priority queue
 
+#include <cassert>
+
 #include <iostream>
-#include <queue>
+#include <random>
 #include <vector>
 using namespace std;
 
-#include "Graph.hpp"
-
-constexpr int INF = 1000000000;
-
-// O(VlogV + E)
-// 对于有向或无向图，有负权边也可以停止，但结果可能不对。
-vector<int> Dijkstra(const Graph &graph, int start) {
-    vector<int> dist(graph.size() + 1, INF);
-    dist[start] = 0;
-    priority_queue<Rela> pq;
-    pq.push({start, 0});
-    vector<bool> visited(graph.size() + 1);
-
-    while(!pq.empty()) {
-        int k = pq.top().node_idx;
-        pq.pop();
-        if(visited[k])
-            continue;
-        for(const auto &e: graph.edges(k)) {
-            if(!visited[e.node_idx] && dist[e.node_idx] > dist[k] + e.dist) {
-                dist[e.node_idx] = dist[k] + e.dist;
-                pq.push({e.node_idx, dist[e.node_idx]});
-            }
-        }
-        visited[k] = true;
-    }
-    return dist;
-}
-
-// 有负环(有向图的负环，无向图的负边即负环)就不会停止，否则(零环、正环)可以得到正确结果。
-// 将priority_queue改为queue就和`SPFASimple()`完全一样了。
-//      所以可以处理有负权边但无负环的图。`SPFASimple()`就可以。
-//      两者的计算结果完全一样，priority_queue可以节省常数时间。
-//      相比于`Dijkstra()`，省去了集合操作。
-//          因为假设没有负权边。
-vector<int> DijkstraSimple(const Graph &graph, int start) {
-    vector<int> dist(graph.size() + 1, INF);
-    dist[start] = 0;
-    priority_queue<Rela> pq;
-    pq.push({start, 0});
-
-    while(!pq.empty()) {
-        int k = pq.top().node_idx;
-        pq.pop();
-        for(const auto &e: graph.edges(k)) {
-            if(dist[e.node_idx] > dist[k] + e.dist) {
-                dist[e.node_idx] = dist[k] + e.dist;
-                pq.push({e.node_idx, dist[e.node_idx]});
-            }
-        }
-    }
-    return dist;
-}
+#include "Dijkstra.hpp"
 
 int main() {
     int n = 5;
@@ -109,6 +59,12 @@ int main() {
                 vector<int> dist = Dijkstra(graph, start);
                 for(auto d: dist)
                     cout << d << "\n";
+                // Same result with CSR layout.
+                assert(Dijkstra(CSRGraph(graph), start) == dist);
+                // Same result with bucket queue. Max weight is 7.
+                assert(DijkstraDial(graph, start, 7) == dist);
+                // Same result with decrease-key.
+                assert(DijkstraDecreaseKey(graph, start) == dist);
             }
 
             cout << "\n";
@@ -131,6 +87,12 @@ int main() {
                 vector<int> dist = Dijkstra(graph, start);
                 for(auto d: dist)
                     cout << d << "\n";
+                // Same result with CSR layout.
+                assert(Dijkstra(CSRGraph(graph), start) == dist);
+                // Same result with bucket queue. Max weight is 7.
+                assert(DijkstraDial(graph, start, 7) == dist);
+                // Same result with decrease-key.
+                assert(DijkstraDecreaseKey(graph, start) == dist);
             }
 
             cout << "\n";
@@ -187,5 +149,22 @@ int main() {
             cout << d << "\n";
     }
 
+    // Random graphs with small integer weights. `DijkstraDial()` and `DijkstraDecreaseKey()` give
+    // the same result as `Dijkstra()`, including `INF` for unreachable nodes.
+    {
+        mt19937 gen(0);
+        for(int t = 0; t < 100; t++) {
+            int n = gen() % 200 + 1;
+            int m = gen() % (n * 4);
+            int max_dist = gen() % 20;
+            Graph graph(n, t % 2);
+            for(int i = 0; i < m; i++)
+                graph.AddEdge(gen() % n + 1, gen() % n + 1, gen() % (max_dist + 1));
+            int start = gen() % n + 1;
+            assert(DijkstraDial(graph, start, max_dist) == Dijkstra(graph, start));
+            assert(DijkstraDecreaseKey(graph, start) == Dijkstra(graph, start));
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+#include "../data_structure/indexed_priority_queue.hpp"
+
+// `GraphType` is `Graph` or `CSRGraph`.
+
+// O(VlogV + E)
+// 对于有向或无向图，有负权边也可以停止，但结果可能不对。
+template<typename GraphType>
+vector<int> Dijkstra(const GraphType &graph, int start) {
+    vector<int> dist(graph.size() + 1, INF);
+    dist[start] = 0;
+    priority_queue<Rela> pq;
+    pq.push({start, 0});
+    vector<bool> visited(graph.size() + 1);
+
+    while(!pq.empty()) {
+        int k = pq.top().node_idx;
+        pq.pop();
+        if(visited[k])
+            continue;
+        for(const auto &e: graph.edges(k)) {
+            if(!visited[e.node_idx] && dist[e.node_idx] > dist[k] + e.dist) {
+                dist[e.node_idx] = dist[k] + e.dist;
+                pq.push({e.node_idx, dist[e.node_idx]});
+            }
+        }
+        visited[k] = true;
+    }
+    return dist;
+}
+
+// 有负环(有向图的负环，无向图的负边即负环)就不会停止，否则(零环、正环)可以得到正确结果。
+// 将priority_queue改为queue就和`SPFASimple()`完全一样了。
+//      所以可以处理有负权边但无负环的图。`SPFASimple()`就可以。
+//      两者的计算结果完全一样，priority_queue可以节省常数时间。
+//      相比于`Dijkstra()`，省去了集合操作。
+//          因为假设没有负权边。
+template<typename GraphType>
+vector<int> DijkstraSimple(const GraphType &graph, int start) {
+    vector<int> dist(graph.size() + 1, INF);
+    dist[start] = 0;
+    priority_queue<Rela> pq;
+    pq.push({start, 0});
+
+    while(!pq.empty()) {
+        int k = pq.top().node_idx;
+        pq.pop();
+        for(const auto &e: graph.edges(k)) {
+            if(dist[e.node_idx] > dist[k] + e.dist) {
+                dist[e.node_idx] = dist[k] + e.dist;
+                pq.push({e.node_idx, dist[e.node_idx]});
+            }
+        }
+    }
+    return dist;
+}
+
+// Dial's algorithm: Dijkstra with a bucket queue instead of a binary heap.
+// Edge weights must be integers in [0, max_dist].
+// Tentative distances in the queue always lie in [d, d + max_dist] when bucket `d` is being
+// processed, so `max_dist + 1` buckets used circularly are enough.
+// Pushing and popping are O(1). A node improved again leaves a stale entry in its old bucket,
+// which is skipped by comparing with `dist`.
+// O(V * max_dist + E)
+template<typename GraphType>
+vector<int> DijkstraDial(const GraphType &graph, int start, int max_dist) {
+    vector<int> dist(graph.size() + 1, INF);
+    dist[start] = 0;
+    vector<vector<int>> buckets(max_dist + 1);
+    buckets[0].push_back(start);
+    size_t queued = 1;
+
+    for(int d = 0, b = 0; queued; d++, b = b == max_dist ? 0 : b + 1) {
+        auto &bucket = buckets[b];
+        // A 0-weight edge pushes to the current bucket, so iterate by index.
+        for(size_t i = 0; i < bucket.size(); i++) {
+            int k = bucket[i];
+            if(dist[k] != d)
+                continue;
+            for(const auto &e: graph.edges(k)) {
+                int new_dist = d + e.dist;
+                if(dist[e.node_idx] > new_dist) {
+                    dist[e.node_idx] = new_dist;
+                    int new_b = b + e.dist;
+                    buckets[new_b > max_dist ? new_b - max_dist - 1 : new_b].push_back(e.node_idx);
+                    queued++;
+                }
+            }
+        }
+        queued -= bucket.size();
+        bucket.clear();
+    }
+    return dist;
+}
+
+// Dijkstra with decrease-key.
+// The heap holds each node at most once, so it never grows beyond V entries, while the heap of
+// `Dijkstra()` holds up to E stale entries.
+// Without negative edges, a popped node is never improved again, so no `visited` is needed.
+// O((V + E)logV)
+template<typename GraphType>
+vector<int> DijkstraDecreaseKey(const GraphType &graph, int start) {
+    vector<int> dist(graph.size() + 1, INF);
+    dist[start] = 0;
+    indexed_priority_queue<int, greater<int>> pq(graph.size() + 1);
+    pq.push(start, 0);
+
+    while(!pq.empty()) {
+        int k = pq.top_key();
+        pq.pop();
+        for(const auto &e: graph.edges(k)) {
+            if(dist[e.node_idx] > dist[k] + e.dist) {
+                dist[e.node_idx] = dist[k] + e.dist;
+                if(pq.contains(e.node_idx))
+                    pq.update(e.node_idx, dist[e.node_idx]);
+                else
+                    pq.push(e.node_idx, dist[e.node_idx]);
+            }
+        }
+    }
+    return dist;
+}
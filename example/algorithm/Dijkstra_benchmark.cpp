@@ -0,0 +1,98 @@
+// Binary heap (`Dijkstra()`) vs. bucket queue (`DijkstraDial()`) across weight ranges.
+
+#include <map>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Dijkstra.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 18;
+
+struct Edge {
+    int a, b, d;
+};
+
+// `n` nodes and `n * 4` random edges with weights in [0, max_dist], plus a chain to keep it
+// connected.
+const CSRGraph &RandomGraph(int max_dist) {
+    static map<int, CSRGraph> cache;
+    auto it = cache.find(max_dist);
+    if(it == cache.end()) {
+        mt19937 gen(max_dist);
+        uniform_int_distribution<int> node(1, n), dist(0, max_dist);
+        vector<Edge> edges;
+        for(int i = 1; i < n; i++)
+            edges.push_back({i, i + 1, dist(gen)});
+        for(int i = 0; i < n * 3; i++)
+            edges.push_back({node(gen), node(gen), dist(gen)});
+        it = cache.emplace(max_dist, CSRGraph(n, edges, false)).first;
+    }
+    return it->second;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the max edge weight.
+
+static void BM_Dijkstra(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(Dijkstra(graph, 1));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Dijkstra)->RangeMultiplier(10)->Range(1, 100000);
+
+static void BM_DijkstraSimple(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(DijkstraSimple(graph, 1));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DijkstraSimple)->RangeMultiplier(10)->Range(1, 100000);
+
+static void BM_DijkstraDial(benchmark::State &state) {
+    int max_dist = state.range(0);
+    const CSRGraph &graph = RandomGraph(max_dist);
+    for(auto _: state)
+        benchmark::DoNotOptimize(DijkstraDial(graph, 1, max_dist));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DijkstraDial)->RangeMultiplier(10)->Range(1, 100000);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* `-O2 -march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+-----------------------------------------------------------------------------------
+Benchmark                         Time             CPU   Iterations UserCounters...
+-----------------------------------------------------------------------------------
+BM_Dijkstra/1             140289348 ns    138095686 ns            2 items_per_second=1.89828M/s
+BM_Dijkstra/10            187243148 ns    186281584 ns            2 items_per_second=1.40725M/s
+BM_Dijkstra/100           193764515 ns    192557572 ns            2 items_per_second=1.36138M/s
+BM_Dijkstra/1000          215996417 ns    215318339 ns            1 items_per_second=1.21747M/s
+BM_Dijkstra/10000         230001610 ns    221733616 ns            1 items_per_second=1.18225M/s
+BM_Dijkstra/100000        225004187 ns    224119878 ns            1 items_per_second=1.16966M/s
+BM_DijkstraSimple/1       168651760 ns    166410842 ns            2 items_per_second=1.57528M/s
+BM_DijkstraSimple/10      238466610 ns    233829164 ns            1 items_per_second=1.12109M/s
+BM_DijkstraSimple/100     229237809 ns    228206689 ns            1 items_per_second=1.14871M/s
+BM_DijkstraSimple/1000    241939766 ns    240093606 ns            1 items_per_second=1091.84k/s
+BM_DijkstraSimple/10000   241402370 ns    240132782 ns            1 items_per_second=1091.66k/s
+BM_DijkstraSimple/100000  251273373 ns    245065300 ns            1 items_per_second=1069.69k/s
+BM_DijkstraDial/1          43584280 ns     43365458 ns            6 items_per_second=6.045M/s
+BM_DijkstraDial/10         50292181 ns     50141599 ns            5 items_per_second=5.22807M/s
+BM_DijkstraDial/100        48819162 ns     48320475 ns            5 items_per_second=5.42511M/s
+BM_DijkstraDial/1000       49399541 ns     49131078 ns            5 items_per_second=5.3356M/s
+BM_DijkstraDial/10000      66491178 ns     66294045 ns            4 items_per_second=3.95426M/s
+BM_DijkstraDial/100000    122796281 ns    120661928 ns            2 items_per_second=2.17255M/s
+
+*/
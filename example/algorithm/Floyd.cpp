@@ -1,51 +1,11 @@
+#include <cassert>
+
 #include <iostream>
-#include <queue>
+#include <random>
 #include <vector>
 using namespace std;
 
-#include "Graph.hpp"
-
-constexpr int INF = 1000000000;
-
-// O(V^3)
-bool Floyd(const Graph &graph, vector<vector<int>> &dist) {
-    dist = vector<vector<int>>(graph.size() + 1, vector<int>(graph.size() + 1, INF));
-    for(int i = 0; i <= graph.size(); i++) {
-        dist[i][i] = 0;
-        for(const auto &e: graph.edges(i))
-            dist[i][e.node_idx] = e.dist;
-    }
-
-    for(int k = 0; k <= graph.size(); k++)
-        for(int i = 0; i <= graph.size(); i++)
-            for(int j = 0; j <= graph.size(); j++)
-                if(dist[i][j] > dist[i][k] + dist[k][j])
-                    dist[i][j] = dist[i][k] + dist[k][j];
-
-    // Detect cycles.
-    for(int i = 0; i <= graph.size(); i++)
-        if(dist[i][i] < 0)
-            return true;
-
-    return false;
-}
-
-vector<vector<int>> FloydSimple(const Graph &graph) {
-    vector<vector<int>> dist(graph.size() + 1, vector<int>(graph.size() + 1, INF));
-    for(int i = 0; i <= graph.size(); i++) {
-        dist[i][i] = 0;
-        for(const auto &e: graph.edges(i))
-            dist[i][e.node_idx] = e.dist;
-    }
-
-    for(int k = 0; k <= graph.size(); k++)
-        for(int i = 0; i <= graph.size(); i++)
-            for(int j = 0; j <= graph.size(); j++)
-                if(dist[i][j] > dist[i][k] + dist[k][j])
-                    dist[i][j] = dist[i][k] + dist[k][j];
-
-    return dist;
-}
+#include "Floyd.hpp"
 
 int main() {
     int n = 5;
@@ -167,5 +127,30 @@ int main() {
         }
     }
 
+    // `FloydBlocked()` on random directed graphs with a few negative edges, compared with
+    // `Floyd()`. Small blocks, so there are many tiles.
+    {
+        ThreadPool pool(4);
+        mt19937 gen(0);
+        for(int t = 0; t < 100; t++) {
+            int n = gen() % 100 + 1;
+            int m = gen() % (n * 4);
+            Graph graph(n, true);
+            for(int i = 0; i < m; i++)
+                graph.AddEdge(gen() % n + 1, gen() % n + 1, int(gen() % 100) - 5);
+
+            vector<vector<int>> dist;
+            DistMatrix dist_blocked;
+            bool cycle = Floyd(graph, dist);
+            assert(FloydBlocked(graph, dist_blocked, pool, 8) == cycle);
+            if(cycle)
+                continue;
+            for(int i = 0; i <= n; i++)
+                for(int j = 0; j <= n; j++)
+                    // `Floyd()` may leave `INF` plus a negative distance for unreachable pairs.
+                    assert(dist_blocked[i][j] == (dist[i][j] > INF / 2 ? INF : dist[i][j]));
+        }
+    }
+
     return 0;
 }
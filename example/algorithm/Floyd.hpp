@@ -0,0 +1,170 @@
+#pragma once
+
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// `GraphType` is `Graph` or `CSRGraph`.
+
+// O(V^3)
+template<typename GraphType>
+bool Floyd(const GraphType &graph, vector<vector<int>> &dist) {
+    dist = vector<vector<int>>(graph.size() + 1, vector<int>(graph.size() + 1, INF));
+    for(int i = 0; i <= graph.size(); i++) {
+        dist[i][i] = 0;
+        for(const auto &e: graph.edges(i))
+            dist[i][e.node_idx] = e.dist;
+    }
+
+    for(int k = 0; k <= graph.size(); k++)
+        for(int i = 0; i <= graph.size(); i++)
+            for(int j = 0; j <= graph.size(); j++)
+                if(dist[i][j] > dist[i][k] + dist[k][j])
+                    dist[i][j] = dist[i][k] + dist[k][j];
+
+    // Detect cycles.
+    for(int i = 0; i <= graph.size(); i++)
+        if(dist[i][i] < 0)
+            return true;
+
+    return false;
+}
+
+template<typename GraphType>
+vector<vector<int>> FloydSimple(const GraphType &graph) {
+    vector<vector<int>> dist(graph.size() + 1, vector<int>(graph.size() + 1, INF));
+    for(int i = 0; i <= graph.size(); i++) {
+        dist[i][i] = 0;
+        for(const auto &e: graph.edges(i))
+            dist[i][e.node_idx] = e.dist;
+    }
+
+    for(int k = 0; k <= graph.size(); k++)
+        for(int i = 0; i <= graph.size(); i++)
+            for(int j = 0; j <= graph.size(); j++)
+                if(dist[i][j] > dist[i][k] + dist[k][j])
+                    dist[i][j] = dist[i][k] + dist[k][j];
+
+    return dist;
+}
+
+// A square matrix in one contiguous allocation, row-major.
+// Rows are `stride()` ints apart, where `stride() >= size()`.
+class DistMatrix {
+    int size_, stride_;
+    vector<int> data_;
+
+public:
+    DistMatrix(): size_(0), stride_(0) {}
+    DistMatrix(int size, int stride)
+        : size_(size), stride_(stride), data_(size_t(stride) * stride, INF) {}
+
+    int size() const {
+        return size_;
+    }
+    int stride() const {
+        return stride_;
+    }
+    int *operator[](int i) {
+        return data_.data() + size_t(i) * stride_;
+    }
+    const int *operator[](int i) const {
+        return data_.data() + size_t(i) * stride_;
+    }
+};
+
+// `c[i][j] = min(c[i][j], a[i][k] + b[k][j])` for one `block * block` tile.
+// `INF` stays `INF`, instead of `INF` plus a negative distance.
+// `k` is the outer loop, as in `Floyd()`, because `c` may be the same tile as `a` or `b`.
+// The inner loop is branchless, so it's vectorized.
+inline void FloydTile(int *c, const int *a, const int *b, int stride, int block) {
+    for(int k = 0; k < block; k++)
+        for(int i = 0; i < block; i++) {
+            int a_ik = a[i * stride + k];
+            if(a_ik == INF)
+                continue;
+            const int *b_k = b + k * stride;
+            int *c_i = c + i * stride;
+            for(int j = 0; j < block; j++) {
+                int d = b_k[j] == INF ? INF : a_ik + b_k[j];
+                c_i[j] = c_i[j] < d ? c_i[j] : d;
+            }
+        }
+}
+
+// Same as `FloydTile()` when `c` is neither `a` nor `b`. Then any loop order is correct, and `c_i`
+// stays in cache while `k` changes.
+inline void FloydTileIndependent(int *c, const int *a, const int *b, int stride, int block) {
+    for(int i = 0; i < block; i++) {
+        int *c_i = c + i * stride;
+        for(int k = 0; k < block; k++) {
+            int a_ik = a[i * stride + k];
+            if(a_ik == INF)
+                continue;
+            const int *b_k = b + k * stride;
+            for(int j = 0; j < block; j++) {
+                int d = b_k[j] == INF ? INF : a_ik + b_k[j];
+                c_i[j] = c_i[j] < d ? c_i[j] : d;
+            }
+        }
+    }
+}
+
+// Blocked Floyd-Warshall.
+// The matrix is split into `block * block` tiles, so each step works on tiles that fit in cache.
+// For each diagonal tile `(kb, kb)`:
+//     Phase 1: `Floyd()` inside tile `(kb, kb)`.
+//     Phase 2: tiles in row `kb` and column `kb`, using tile `(kb, kb)`. Independent of each other.
+//     Phase 3: all other tiles `(ib, jb)`, using tiles `(ib, kb)` and `(kb, jb)`. Independent of
+//              each other.
+// Phases 2 and 3 run on `pool`.
+// `dist` is padded to a multiple of `block`. Padding nodes are unreachable, so they change nothing.
+// Same distances as `Floyd()`, except that unreachable pairs are always exactly `INF`.
+// O(V^3)
+template<typename GraphType>
+bool FloydBlocked(const GraphType &graph, DistMatrix &dist, ThreadPool &pool, int block = 64) {
+    int n = graph.size() + 1;
+    int n_block = (n + block - 1) / block;
+    int stride = n_block * block;
+    dist = DistMatrix(n, stride);
+    for(int i = 0; i < stride; i++)
+        dist[i][i] = 0;
+    for(int i = 0; i < n; i++)
+        for(const auto &e: graph.edges(i))
+            dist[i][e.node_idx] = e.dist;
+
+    auto tile = [&](int ib, int jb) {
+        return dist[ib * block] + jb * block;
+    };
+    for(int kb = 0; kb < n_block; kb++) {
+        int *diagonal = tile(kb, kb);
+        FloydTile(diagonal, diagonal, diagonal, stride, block);
+
+        pool.ParallelFor((n_block - 1) * 2, [&](int t) {
+            int b = t / 2 < kb ? t / 2 : t / 2 + 1;
+            if(t % 2 == 0) {
+                int *row = tile(kb, b);
+                FloydTile(row, diagonal, row, stride, block);
+            } else {
+                int *column = tile(b, kb);
+                FloydTile(column, column, diagonal, stride, block);
+            }
+        });
+
+        pool.ParallelFor((n_block - 1) * (n_block - 1), [&](int t) {
+            int ib = t / (n_block - 1), jb = t % (n_block - 1);
+            ib += ib >= kb;
+            jb += jb >= kb;
+            FloydTileIndependent(tile(ib, jb), tile(ib, kb), tile(kb, jb), stride, block);
+        });
+    }
+
+    // Detect cycles.
+    for(int i = 0; i < n; i++)
+        if(dist[i][i] < 0)
+            return true;
+
+    return false;
+}
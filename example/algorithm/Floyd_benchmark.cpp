@@ -0,0 +1,107 @@
+// `Floyd()` vs. `FloydBlocked()` with 1 thread and all hardware threads.
+// `ThreadPool` uses the calling thread too, so it has one worker less than the thread count.
+
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Floyd.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+struct Edge {
+    int a, b, d;
+};
+
+// `n` nodes and `n * 8` random directed edges with positive weights.
+const CSRGraph &RandomGraph(int n) {
+    static map<int, CSRGraph> cache;
+    auto it = cache.find(n);
+    if(it == cache.end()) {
+        mt19937 gen(n);
+        uniform_int_distribution<int> node(1, n), dist(1, 100);
+        vector<Edge> edges;
+        for(int i = 0; i < n * 8; i++)
+            edges.push_back({node(gen), node(gen), dist(gen)});
+        it = cache.emplace(n, CSRGraph(n, edges, true)).first;
+    }
+    return it->second;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the node count.
+
+static void BM_Floyd(benchmark::State &state) {
+    int n = state.range(0);
+    const CSRGraph &graph = RandomGraph(n);
+    vector<vector<int>> dist;
+    for(auto _: state)
+        benchmark::DoNotOptimize(Floyd(graph, dist));
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_Floyd)->RangeMultiplier(2)->Range(256, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_FloydBlocked_1Thread(benchmark::State &state) {
+    int n = state.range(0);
+    const CSRGraph &graph = RandomGraph(n);
+    ThreadPool pool(0);
+    DistMatrix dist;
+    for(auto _: state)
+        benchmark::DoNotOptimize(FloydBlocked(graph, dist, pool));
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_FloydBlocked_1Thread)
+    ->RangeMultiplier(2)
+    ->Range(256, 8192)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FloydBlocked(benchmark::State &state) {
+    int n = state.range(0);
+    const CSRGraph &graph = RandomGraph(n);
+    ThreadPool pool(thread::hardware_concurrency() - 1);
+    DistMatrix dist;
+    for(auto _: state)
+        benchmark::DoNotOptimize(FloydBlocked(graph, dist, pool));
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+    state.counters["threads"] = pool.size() + 1;
+}
+BENCHMARK(BM_FloydBlocked)
+    ->RangeMultiplier(2)
+    ->Range(256, 8192)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+-----------------------------------------------------------------------------------------
+Benchmark                               Time             CPU   Iterations UserCounters...
+-----------------------------------------------------------------------------------------
+BM_Floyd/256                         17.6 ms         16.6 ms           41 items_per_second=1009.75M/s
+BM_Floyd/512                          125 ms          120 ms            6 items_per_second=1.11625G/s
+BM_Floyd/1024                         959 ms          936 ms            1 items_per_second=1.14707G/s
+BM_FloydBlocked_1Thread/256          3.87 ms         3.50 ms          213 items_per_second=4.78961G/s
+BM_FloydBlocked_1Thread/512          23.6 ms         22.9 ms           31 items_per_second=5.85126G/s
+BM_FloydBlocked_1Thread/1024          178 ms          174 ms            4 items_per_second=6.16331G/s
+BM_FloydBlocked_1Thread/2048         1592 ms         1566 ms            1 items_per_second=5.48432G/s
+BM_FloydBlocked_1Thread/4096        12913 ms        12451 ms            1 items_per_second=5.51913G/s
+BM_FloydBlocked_1Thread/8192       105843 ms        99930 ms            1 items_per_second=5.50142G/s
+BM_FloydBlocked/256/real_time        5.04 ms         3.36 ms          203 items_per_second=3.32711G/s threads=1
+BM_FloydBlocked/512/real_time        23.8 ms         21.7 ms           26 items_per_second=5.64201G/s threads=1
+BM_FloydBlocked/1024/real_time        172 ms          171 ms            4 items_per_second=6.23673G/s threads=1
+BM_FloydBlocked/2048/real_time       1690 ms         1540 ms            1 items_per_second=5.08219G/s threads=1
+BM_FloydBlocked/4096/real_time      12438 ms        11900 ms            1 items_per_second=5.52494G/s threads=1
+BM_FloydBlocked/8192/real_time      98935 ms        96115 ms            1 items_per_second=5.55673G/s threads=1
+
+*/
@@ -1,16 +1,46 @@
+#pragma once
+
 #include <vector>
 using namespace std;
 
+constexpr int INF = 1000000000;
+
 // `node_idx` can be [0, n-1] or [1, n].
 // A Rela represents distance `dist` to node `node_idx`.
 struct Rela {
     int node_idx, dist;
+    Rela() = default;
     Rela(int num, int dist): node_idx(num), dist(dist) {}
     bool operator<(const Rela &rela) const {
         return dist > rela.dist;
     }
 };
 
+// A read-only view of contiguous `T`s, like C++20 `std::span`.
+template<typename T>
+class Span {
+    const T *begin_, *end_;
+
+public:
+    Span(const T *begin, const T *end): begin_(begin), end_(end) {}
+
+    const T *begin() const {
+        return begin_;
+    }
+    const T *end() const {
+        return end_;
+    }
+    size_t size() const {
+        return end_ - begin_;
+    }
+    bool empty() const {
+        return begin_ == end_;
+    }
+    const T &operator[](size_t i) const {
+        return begin_[i];
+    }
+};
+
 class Graph {
     int size_;
     bool directed_;
@@ -30,7 +60,75 @@ public:
     int size() const {
         return size_;
     }
+    bool directed() const {
+        return directed_;
+    }
     const vector<Rela> &edges(int k) const {
         return edges_[k];
     }
 };
+
+// CSR (Compressed Sparse Row) graph.
+// Immutable. All edges are packed into one array, and the edges of node `i` are
+// `edges_[offsets_[i]]` to `edges_[offsets_[i + 1] - 1]`.
+// Two allocations in total instead of one per node, and neighboring nodes' edges are adjacent in
+// memory, so relaxations don't chase pointers.
+class CSRGraph {
+    int size_;
+    bool directed_;
+    vector<int> offsets_; // size_ + 2 elements.
+    vector<Rela> edges_;
+
+    template<typename ForEachEdge>
+    void Build(ForEachEdge for_each_edge) {
+        offsets_.assign(size_ + 2, 0);
+        // Count the out-degrees, shifted by one.
+        for_each_edge([&](int a, int b, int) {
+            offsets_[a + 1]++;
+            if(!directed_)
+                offsets_[b + 1]++;
+        });
+        for(int i = 1; i <= size_ + 1; i++)
+            offsets_[i] += offsets_[i - 1];
+
+        // Scatter the edges. `cursor[i]` is the next free slot of node `i`.
+        edges_.resize(offsets_[size_ + 1]);
+        vector<int> cursor(offsets_.begin(), offsets_.end() - 1);
+        for_each_edge([&](int a, int b, int d) {
+            edges_[cursor[a]++] = {b, d};
+            if(!directed_)
+                edges_[cursor[b]++] = {a, d};
+        });
+    }
+
+public:
+    // `edges` is any container of `{a, b, d}` structs, e.g. `vector<Edge>`.
+    template<typename Edges>
+    CSRGraph(int size, const Edges &edges, bool directed = false)
+        : size_(size), directed_(directed) {
+        Build([&](auto f) {
+            for(const auto &e: edges)
+                f(e.a, e.b, e.d);
+        });
+    }
+
+    explicit CSRGraph(const Graph &graph): size_(graph.size()), directed_(true) {
+        // Undirected edges are already stored in both directions in `graph`.
+        Build([&](auto f) {
+            for(int i = 0; i <= graph.size(); i++)
+                for(const auto &e: graph.edges(i))
+                    f(i, e.node_idx, e.dist);
+        });
+        directed_ = graph.directed();
+    }
+
+    int size() const {
+        return size_;
+    }
+    bool directed() const {
+        return directed_;
+    }
+    Span<Rela> edges(int k) const {
+        return {edges_.data() + offsets_[k], edges_.data() + offsets_[k + 1]};
+    }
+};
@@ -2,67 +2,32 @@
 
 #include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <vector>
 using namespace std;
 
-class Hungarian {
-    int n_;
-    bool floyd_;
-    vector<vector<bool>> connected_;
-    vector<bool> visited_;
-    vector<int> matched_from_;
+#include "Hungarian.hpp"
 
-    void Floyd() {
-        for(int k = 1; k <= n_; k++)
-            for(int i = 1; i <= n_; i++)
-                for(int j = 1; j <= n_; j++)
-                    if(connected_[i][k] && connected_[k][j])
-                        connected_[i][j] = true;
+// Each left node is matched to at most one right node it's connected to, and the other way.
+bool IsMatching(const HopcroftKarp &matcher, int n, const vector<vector<int>> &connections,
+                int match_count) {
+    vector<vector<bool>> connected(n + 1, vector<bool>(n + 1));
+    for(const auto &c: connections)
+        connected[c[0]][c[1]] = true;
+    vector<bool> used(n + 1);
+    int count = 0;
+    for(int i = 1; i <= n; i++) {
+        int j = matcher.matched_to(i);
+        if(j == 0)
+            continue;
+        if(!connected[i][j] || used[j])
+            return false;
+        used[j] = true;
+        count++;
     }
-
-    bool DFS(int k) {
-        for(int i = 1; i <= n_; i++)
-            if(!visited_[i] && connected_[k][i]) {
-                visited_[i] = true;
-                if(matched_from_[i] == -1 || DFS(matched_from_[i])) {
-                    matched_from_[i] = k;
-                    return true;
-                }
-            }
-        return false;
-    }
-
-public:
-    // Index 0 is ignored.
-    // connections: int connections[connection_count][2];
-    // floyd: extend connections with Floyd.
-    void Build(int n, const vector<vector<int>> &connections, bool floyd = false) {
-        n_ = n;
-        floyd_ = floyd;
-        connected_.clear();
-        connected_.resize(n_ + 1, vector<bool>(n_ + 1));
-        for(auto &v: connected_)
-            fill(v.begin(), v.end(), 0);
-        for(const auto &c: connections)
-            connected_[c[0]][c[1]] = true;
-        if(floyd_)
-            Floyd();
-
-        visited_.resize(n_ + 1);
-        matched_from_.resize(n_ + 1);
-    }
-
-    int Match() {
-        fill(matched_from_.begin(), matched_from_.end(), -1);
-        int match_count = 0;
-        for(int i = 1; i <= n_; i++) {
-            fill(visited_.begin(), visited_.end(), false);
-            if(DFS(i))
-                match_count++;
-        }
-        return match_count;
-    }
-};
+    return count == match_count;
+}
 
 int main() {
     int n = 5;
@@ -83,5 +48,104 @@ int main() {
     hungarian.Build(n, connections, true);
     assert(hungarian.Match() == 3);
 
+    HopcroftKarp hopcroft_karp;
+    hopcroft_karp.Build(n, connections, false);
+    assert(hopcroft_karp.Match() == 2);
+    hopcroft_karp.Build(n, connections, true);
+    assert(hopcroft_karp.Match() == 3);
+
+    // Random graphs, sparse to dense, against `Hungarian`.
+    mt19937 gen(0);
+    for(int n: {1, 2, 10, 100, 300})
+        for(int degree: {1, 2, 3, 10})
+            for(bool floyd: {false, true}) {
+                vector<vector<int>> connections;
+                for(int i = 0; i < n * degree / 2; i++)
+                    connections.push_back({int(gen() % n) + 1, int(gen() % n) + 1});
+                hungarian.Build(n, connections, floyd);
+                hopcroft_karp.Build(n, connections, floyd);
+                int match_count = hopcroft_karp.Match();
+                assert(match_count == hungarian.Match());
+                if(!floyd)
+                    assert(IsMatching(hopcroft_karp, n, connections, match_count));
+            }
+
+    // Left node i is connected to i + 1, then to i. The greedy matching pairs i with i + 1 and
+    // leaves n out, so the only augmenting path goes through all nodes: n, n - 1, ..., 1.
+    n = 100000;
+    connections.clear();
+    for(int i = 1; i <= n; i++) {
+        if(i < n)
+            connections.push_back({i, i + 1});
+        connections.push_back({i, i});
+    }
+    hopcroft_karp.Build(n, connections);
+    assert(hopcroft_karp.Match() == n);
+
+    // The closure against Floyd's algorithm.
+    for(int n: {1, 63, 64, 65, 200}) {
+        BitMatrix bits(n);
+        vector<vector<bool>> connected(n + 1, vector<bool>(n + 1));
+        for(int i = 0; i < n; i++) {
+            int a = gen() % n + 1, b = gen() % n + 1;
+            bits.Set(a, b);
+            connected[a][b] = true;
+        }
+        bits.TransitiveClosure();
+        for(int k = 1; k <= n; k++)
+            for(int i = 1; i <= n; i++)
+                for(int j = 1; j <= n; j++)
+                    if(connected[i][k] && connected[k][j])
+                        connected[i][j] = true;
+        for(int i = 1; i <= n; i++) {
+            vector<int> row;
+            bits.ForEach(i, [&](int j) {
+                row.push_back(j);
+            });
+            for(int j = 0, r = 0; j <= n; j++) {
+                assert(bits.Test(i, j) == connected[i][j]);
+                if(connected[i][j])
+                    assert(row[r++] == j);
+            }
+        }
+    }
+
+    // Assignments against all permutations, square and with more columns than rows.
+    vector<int> assignment;
+    assert(MinCostAssignment(vector<vector<int>>{}, assignment) == 0 && assignment.empty());
+    for(int t = 0; t < 100; t++) {
+        int rows = gen() % 6 + 1, columns = rows + gen() % 3;
+        vector<vector<int>> cost(rows, vector<int>(columns));
+        for(auto &row: cost)
+            for(int &c: row)
+                c = int(gen() % 200) - 50;
+        int total = MinCostAssignment(cost, assignment);
+        int sum = 0;
+        vector<bool> used(columns);
+        for(int i = 0; i < rows; i++) {
+            assert(!used[assignment[i]]);
+            used[assignment[i]] = true;
+            sum += cost[i][assignment[i]];
+        }
+        assert(sum == total);
+        vector<int> p(columns);
+        iota(p.begin(), p.end(), 0);
+        int best = numeric_limits<int>::max();
+        do {
+            int s = 0;
+            for(int i = 0; i < rows; i++)
+                s += cost[i][p[i]];
+            best = min(best, s);
+        } while(next_permutation(p.begin(), p.end()));
+        assert(total == best);
+    }
+    vector<vector<double>> cost{
+        {4, 1, 3},
+        {2, 0, 5},
+        {3, 2, 2},
+    };
+    assert(MinCostAssignment(cost, assignment) == 5);
+    assert((assignment == vector<int>{1, 0, 2}));
+
     return 0;
 }
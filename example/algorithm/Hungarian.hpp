@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+using namespace std;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class Hungarian {
+    int n_;
+    bool floyd_;
+    vector<vector<bool>> connected_;
+    vector<bool> visited_;
+    vector<int> matched_from_;
+
+    void Floyd() {
+        for(int k = 1; k <= n_; k++)
+            for(int i = 1; i <= n_; i++)
+                for(int j = 1; j <= n_; j++)
+                    if(connected_[i][k] && connected_[k][j])
+                        connected_[i][j] = true;
+    }
+
+    bool DFS(int k) {
+        for(int i = 1; i <= n_; i++)
+            if(!visited_[i] && connected_[k][i]) {
+                visited_[i] = true;
+                if(matched_from_[i] == -1 || DFS(matched_from_[i])) {
+                    matched_from_[i] = k;
+                    return true;
+                }
+            }
+        return false;
+    }
+
+public:
+    // Index 0 is ignored.
+    // connections: int connections[connection_count][2];
+    // floyd: extend connections with Floyd.
+    void Build(int n, const vector<vector<int>> &connections, bool floyd = false) {
+        n_ = n;
+        floyd_ = floyd;
+        connected_.clear();
+        connected_.resize(n_ + 1, vector<bool>(n_ + 1));
+        for(auto &v: connected_)
+            fill(v.begin(), v.end(), 0);
+        for(const auto &c: connections)
+            connected_[c[0]][c[1]] = true;
+        if(floyd_)
+            Floyd();
+
+        visited_.resize(n_ + 1);
+        matched_from_.resize(n_ + 1);
+    }
+
+    int Match() {
+        fill(matched_from_.begin(), matched_from_.end(), -1);
+        int match_count = 0;
+        for(int i = 1; i <= n_; i++) {
+            fill(visited_.begin(), visited_.end(), false);
+            if(DFS(i))
+                match_count++;
+        }
+        return match_count;
+    }
+};
+
+// An (n + 1) x (n + 1) matrix of bits, row by row with 64 columns per word. Index 0 is ignored.
+class BitMatrix {
+    int n_;
+    size_t words_; // Per row.
+    vector<uint64_t> bits_;
+
+public:
+    explicit BitMatrix(int n): n_(n), words_(n / 64 + 1), bits_((n + 1) * words_) {}
+
+    void Set(int i, int j) {
+        bits_[i * words_ + j / 64] |= uint64_t(1) << (j % 64);
+    }
+    bool Test(int i, int j) const {
+        return bits_[i * words_ + j / 64] >> (j % 64) & 1;
+    }
+
+    // Warshall's algorithm, like `Hungarian::Floyd()`: row i gets row k for each i with (i, k) set,
+    // so a whole row is done in n / 64 word operations instead of n. O(n^3 / 64).
+    void TransitiveClosure() {
+        for(int k = 1; k <= n_; k++) {
+            const uint64_t *row_k = &bits_[k * words_];
+            for(int i = 1; i <= n_; i++)
+                if(Test(i, k)) {
+                    uint64_t *row_i = &bits_[i * words_];
+                    for(size_t w = 0; w < words_; w++)
+                        row_i[w] |= row_k[w];
+                }
+        }
+    }
+
+    // Call `f(j)` for each j with (i, j) set, in increasing order.
+    template<typename F>
+    void ForEach(int i, F f) const {
+        for(size_t w = 0; w < words_; w++)
+            for(uint64_t bits = bits_[i * words_ + w]; bits; bits &= bits - 1) {
+#ifdef _MSC_VER
+                unsigned long j;
+                _BitScanForward64(&j, bits);
+#else
+                int j = __builtin_ctzll(bits);
+#endif
+                f(int(w * 64 + j));
+            }
+    }
+};
+
+// Maximum bipartite matching by Hopcroft-Karp, O(E sqrt(V)), with the interface of `Hungarian`.
+// Edges are kept as adjacency lists in one array (CSR), so memory is O(V + E) rather than the
+// O(V^2) of `Hungarian`. Each phase finds the shortest augmenting paths by a BFS from all free left
+// nodes, then a maximal set of disjoint ones among them by DFS, which resumes each node's edges
+// where it stopped, so a phase is O(E), and there are O(sqrt(V)) phases.
+// The DFS keeps its own stack, since paths can be as long as the graph.
+class HopcroftKarp {
+    static constexpr int inf = numeric_limits<int>::max();
+
+    int n_;
+    // Left node i has edges to `edges_[offsets_[i]]` to `edges_[offsets_[i + 1] - 1]`.
+    vector<int> offsets_;
+    vector<int> edges_;
+    // Partners, 0 for none.
+    vector<int> match_left_, match_right_;
+    vector<int> dist_; // BFS layer of left nodes, with `dist_[0]` the layer of free right nodes.
+    vector<int> next_edge_, stack_;
+
+    bool BFS() {
+        stack_.clear(); // As a queue.
+        for(int u = 1; u <= n_; u++) {
+            dist_[u] = match_left_[u] ? inf : 0;
+            if(!match_left_[u])
+                stack_.push_back(u);
+        }
+        dist_[0] = inf;
+        for(size_t q = 0; q < stack_.size(); q++) {
+            int u = stack_[q];
+            if(dist_[u] >= dist_[0])
+                continue;
+            for(int e = offsets_[u]; e < offsets_[u + 1]; e++) {
+                int w = match_right_[edges_[e]];
+                if(dist_[w] == inf) {
+                    dist_[w] = dist_[u] + 1;
+                    if(w)
+                        stack_.push_back(w);
+                }
+            }
+        }
+        return dist_[0] != inf;
+    }
+
+    // Augment along a shortest path from the free left node `root`, if there is one left.
+    bool DFS(int root) {
+        stack_.assign(1, root);
+        while(!stack_.empty()) {
+            int u = stack_.back();
+            if(next_edge_[u] == offsets_[u + 1]) {
+                dist_[u] = inf; // No path through `u` in this phase.
+                stack_.pop_back();
+                continue;
+            }
+            int w = match_right_[edges_[next_edge_[u]]];
+            if(dist_[w] == dist_[u] + 1) {
+                if(w == 0) {
+                    // Each node on the stack takes the right node its current edge goes to.
+                    for(int k: stack_) {
+                        int v = edges_[next_edge_[k]];
+                        match_left_[k] = v;
+                        match_right_[v] = k;
+                    }
+                    return true;
+                }
+                stack_.push_back(w);
+            } else {
+                next_edge_[u]++;
+            }
+        }
+        return false;
+    }
+
+public:
+    // Like `Hungarian::Build()`. With `floyd`, the connections are extended by
+    // `BitMatrix::TransitiveClosure()`, which takes (n + 1)^2 / 8 bytes.
+    void Build(int n, const vector<vector<int>> &connections, bool floyd = false) {
+        n_ = n;
+        offsets_.assign(n_ + 2, 0);
+        edges_.clear();
+        if(floyd) {
+            BitMatrix connected(n_);
+            for(const auto &c: connections)
+                connected.Set(c[0], c[1]);
+            connected.TransitiveClosure();
+            for(int i = 1; i <= n_; i++) {
+                connected.ForEach(i, [&](int j) {
+                    edges_.push_back(j);
+                });
+                offsets_[i + 1] = edges_.size();
+            }
+        } else {
+            for(const auto &c: connections)
+                offsets_[c[0] + 1]++;
+            for(int i = 1; i <= n_ + 1; i++)
+                offsets_[i] += offsets_[i - 1];
+            edges_.resize(connections.size());
+            vector<int> cursor(offsets_.begin(), offsets_.end() - 1);
+            for(const auto &c: connections)
+                edges_[cursor[c[0]]++] = c[1];
+        }
+        match_left_.resize(n_ + 1);
+        match_right_.resize(n_ + 1);
+        dist_.resize(n_ + 1);
+    }
+
+    int Match() {
+        fill(match_left_.begin(), match_left_.end(), 0);
+        fill(match_right_.begin(), match_right_.end(), 0);
+        // Greedy first, which leaves few paths for the phases.
+        int match_count = 0;
+        for(int u = 1; u <= n_; u++)
+            for(int e = offsets_[u]; e < offsets_[u + 1]; e++)
+                if(!match_right_[edges_[e]]) {
+                    match_left_[u] = edges_[e];
+                    match_right_[edges_[e]] = u;
+                    match_count++;
+                    break;
+                }
+        while(BFS()) {
+            next_edge_.assign(offsets_.begin(), offsets_.end() - 1);
+            for(int u = 1; u <= n_; u++)
+                if(!match_left_[u] && DFS(u))
+                    match_count++;
+        }
+        return match_count;
+    }
+
+    // The right node matched to left node `i` by the last `Match()`, or 0.
+    int matched_to(int i) const {
+        return match_left_[i];
+    }
+};
+
+// Minimum-cost assignment of the n rows of `cost` to distinct columns out of m >= n, i.e. the
+// weighted version of the matching above. Returns the total cost, and `assignment[i]` is the
+// column of row i. Indexes start from 0. Forbid a pair with a cost larger than any assignment.
+// Shortest augmenting paths with dual potentials, the augmentation of Jonker-Volgenant: rows are
+// added one by one, each by a Dijkstra search over the reduced costs, which the potentials keep
+// non-negative, to the nearest free column. O(n^2 m), on a flat row-major copy of `cost`.
+template<typename T>
+T MinCostAssignment(const vector<vector<T>> &cost, vector<int> &assignment) {
+    int n = cost.size(), m = n ? cost[0].size() : 0;
+    assert(m >= n);
+    const T inf = numeric_limits<T>::max();
+    // 1-based, column 0 is where the path starts.
+    vector<T> a((n + 1) * size_t(m + 1));
+    for(int i = 1; i <= n; i++)
+        copy(cost[i - 1].begin(), cost[i - 1].end(), a.begin() + i * size_t(m + 1) + 1);
+    vector<T> u(n + 1), v(m + 1), min_dist(m + 1);
+    vector<int> row_of(m + 1), prev(m + 1); // Row assigned to each column, and the path.
+    vector<char> done(m + 1);
+    for(int i = 1; i <= n; i++) {
+        row_of[0] = i;
+        int j0 = 0;
+        fill(min_dist.begin(), min_dist.end(), inf);
+        fill(done.begin(), done.end(), 0);
+        do {
+            done[j0] = 1;
+            int i0 = row_of[j0], j1 = 0;
+            T delta = inf;
+            const T *row = &a[i0 * size_t(m + 1)];
+            for(int j = 1; j <= m; j++)
+                if(!done[j]) {
+                    T reduced = row[j] - u[i0] - v[j];
+                    if(reduced < min_dist[j]) {
+                        min_dist[j] = reduced;
+                        prev[j] = j0;
+                    }
+                    if(min_dist[j] < delta) {
+                        delta = min_dist[j];
+                        j1 = j;
+                    }
+                }
+            for(int j = 0; j <= m; j++)
+                if(done[j]) {
+                    u[row_of[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    min_dist[j] -= delta;
+                }
+            j0 = j1;
+        } while(row_of[j0] != 0);
+        // Shift the rows along the path.
+        for(int j1; j0; j0 = j1) {
+            j1 = prev[j0];
+            row_of[j0] = row_of[j1];
+        }
+    }
+    assignment.assign(n, -1);
+    T total = 0;
+    for(int j = 1; j <= m; j++)
+        if(row_of[j]) {
+            assignment[row_of[j] - 1] = j - 1;
+            total += cost[row_of[j] - 1][j - 1];
+        }
+    return total;
+}
@@ -3,71 +3,13 @@
 
 #include <cassert>
 
-#include <algorithm>
 #include <iostream>
+#include <random>
 #include <vector>
 using namespace std;
 
-struct Edge {
-    int a, b, d;
-    bool operator<(const Edge &e) const {
-        return d < e.d;
-    }
-};
-
-class DisjointSets {
-    std::vector<int> parent_;
-    std::vector<int> rank_;
-
-    int Find(int x) {
-        if(parent_[x] == x)
-            return x;
-        else
-            return parent_[x] = Find(parent_[x]);
-    }
-
-public:
-    // Indexes start from 0 or 1.
-    DisjointSets(int size): parent_(size + 1), rank_(size + 1) {
-        for(int i = 0; i <= size; i++)
-            parent_[i] = i;
-    }
-
-    void Unite(int x0, int x1) {
-        int f0 = Find(x0);
-        int f1 = Find(x1);
-        if(rank_[f0] > rank_[f1]) {
-            parent_[f1] = f0;
-        } else {
-            parent_[f0] = f1;
-            if(rank_[f0] == rank_[f1])
-                rank_[f1]++;
-        }
-    }
-
-    bool IsSame(int x0, int x1) {
-        return Find(x0) == Find(x1);
-    }
-};
-
-int Kruskal(int n, const vector<Edge> &_edges) {
-    DisjointSets ds(n);
-    vector<Edge> edges = _edges;
-    sort(edges.begin(), edges.end());
-
-    int sum = 0;
-    int count = 0;
-    for(const auto &e: edges) {
-        if(!ds.IsSame(e.a, e.b)) {
-            ds.Unite(e.a, e.b);
-            sum += e.d;
-            count++;
-            if(count == n - 1)
-                break;
-        }
-    }
-    return sum;
-}
+#include "Boruvka.hpp"
+#include "Kruskal.hpp"
 
 int main() {
     int n = 6;
@@ -85,4 +27,60 @@ int main() {
     };
 
     assert(Kruskal(n, edges) == 15);
+
+    ThreadPool pool(3);
+    assert(FilterKruskal(n, pool).Run(edges) == 15);
+
+    {
+        vector<Edge> tree;
+        assert(Boruvka(n, pool).Run(edges, tree) == 15);
+        assert(int(tree.size()) == n - 1);
+        cout << "Boruvka tree:";
+        for(const auto &e: tree)
+            cout << " (" << e.a << ", " << e.b << ", " << e.d << ")";
+        cout << endl;
+    }
+
+    {
+        mt19937 gen(1);
+        vector<Edge> edges(100000);
+        for(auto &e: edges)
+            e = {0, 0, int(gen() % 1000)};
+        vector<Edge> sorted = edges;
+        ParallelSort(sorted.begin(), sorted.end(), pool);
+        sort(edges.begin(), edges.end());
+        for(size_t i = 0; i < edges.size(); i++)
+            assert(sorted[i].d == edges[i].d);
+    }
+
+    // Random graphs, connected or not, with few or many equal weights, against `Kruskal()`.
+    mt19937 gen(0);
+    for(int t = 0; t < 100; t++) {
+        int n = gen() % 5000 + 1;
+        int m = gen() % (n * 8);
+        int max_dist = t % 4 == 0 ? 2 : 1000;
+        vector<Edge> edges(m);
+        for(auto &e: edges)
+            e = {int(gen() % n + 1), int(gen() % n + 1), int(gen() % max_dist)};
+        int sum = Kruskal(n, edges);
+        assert(FilterKruskal(n, pool).Run(edges) == sum);
+
+        // A spanning forest with the same weight: `n - components` edges and no cycles.
+        vector<Edge> tree;
+        assert(Boruvka(n, pool).Run(edges, tree) == sum);
+        DisjointSets all(n), forest(n);
+        int components = n;
+        for(const auto &e: edges)
+            if(!all.IsSame(e.a, e.b)) {
+                all.Unite(e.a, e.b);
+                components--;
+            }
+        assert(int(tree.size()) == n - components);
+        for(const auto &e: tree) {
+            assert(!forest.IsSame(e.a, e.b));
+            forest.Unite(e.a, e.b);
+        }
+    }
+
+    return 0;
 }
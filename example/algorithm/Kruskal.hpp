@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+#include "ThreadPool.hpp"
+#include "../data_structure/disjoint_sets.hpp"
+
+struct Edge {
+    int a, b, d;
+    bool operator<(const Edge &e) const {
+        return d < e.d;
+    }
+};
+
+int Kruskal(int n, const vector<Edge> &_edges) {
+    DisjointSets ds(n);
+    vector<Edge> edges = _edges;
+    sort(edges.begin(), edges.end());
+
+    int sum = 0;
+    int count = 0;
+    for(const auto &e: edges) {
+        if(!ds.IsSame(e.a, e.b)) {
+            ds.Unite(e.a, e.b);
+            sum += e.d;
+            count++;
+            if(count == n - 1)
+                break;
+        }
+    }
+    return sum;
+}
+
+// Sort [first, last) on `pool`. Chunks are sorted in parallel, then merged pairwise in parallel
+// rounds.
+template<typename It>
+void ParallelSort(It first, It last, ThreadPool &pool) {
+    int n_chunk = pool.size() + 1;
+    size_t n = last - first;
+    if(n_chunk == 1 || n < size_t(1) << 14) {
+        sort(first, last);
+        return;
+    }
+    vector<size_t> bounds(n_chunk + 1);
+    for(int i = 0; i <= n_chunk; i++)
+        bounds[i] = n * i / n_chunk;
+    pool.ParallelFor(n_chunk, [&](int i) {
+        sort(first + bounds[i], first + bounds[i + 1]);
+    });
+    for(int width = 1; width < n_chunk; width *= 2) {
+        pool.ParallelFor((n_chunk + width * 2 - 1) / (width * 2), [&](int i) {
+            int low = i * width * 2, mid = min(low + width, n_chunk);
+            int high = min(low + width * 2, n_chunk);
+            if(mid < high)
+                inplace_merge(first + bounds[low], first + bounds[mid], first + bounds[high]);
+        });
+    }
+}
+
+// Remove the elements of [first, last) for which `pred` is true, keeping the order, and return
+// the new end. Chunks are compacted in parallel, then moved together.
+template<typename It, typename Pred>
+It ParallelRemoveIf(It first, It last, Pred pred, ThreadPool &pool) {
+    int n_chunk = pool.size() + 1;
+    size_t n = last - first;
+    vector<size_t> begin(n_chunk + 1), end(n_chunk);
+    for(int i = 0; i <= n_chunk; i++)
+        begin[i] = n * i / n_chunk;
+    pool.ParallelFor(n_chunk, [&](int i) {
+        end[i] = remove_if(first + begin[i], first + begin[i + 1], pred) - first;
+    });
+    It out = first + end[0];
+    for(int i = 1; i < n_chunk; i++)
+        out = move(first + begin[i], first + end[i], out);
+    return out;
+}
+
+// Filter-Kruskal (Osipov, Sanders, Singler 2009).
+// Edges are partitioned around a pivot weight like quicksort. The light part is solved first,
+// then edges of the heavy part inside one component are filtered out before it's solved, so most
+// heavy edges are never sorted. Small parts are solved like `Kruskal()`, with `ParallelSort()`.
+// Filtering runs in parallel with `ConcurrentDisjointSets::Find()`.
+// Same result as `Kruskal()`.
+// Usage: `FilterKruskal(n, pool).Run(edges)`.
+class FilterKruskal {
+    int n_;
+    ThreadPool &pool_;
+    ConcurrentDisjointSets ds_;
+    int sum_ = 0, count_ = 0;
+
+    // Parts of at most this many edges are sorted.
+    size_t BaseSize() const {
+        return max(n_, 1 << 12);
+    }
+
+    void Base(Edge *first, Edge *last) {
+        ParallelSort(first, last, pool_);
+        for(Edge *e = first; e != last && count_ < n_ - 1; e++)
+            if(ds_.Unite(e->a, e->b)) {
+                sum_ += e->d;
+                count_++;
+            }
+    }
+
+    // Median weight of evenly spaced samples.
+    static int Pivot(const Edge *first, const Edge *last) {
+        constexpr int n_sample = 63;
+        size_t n = last - first;
+        int samples[n_sample];
+        for(int i = 0; i < n_sample; i++)
+            samples[i] = first[n * i / n_sample].d;
+        nth_element(samples, samples + n_sample / 2, samples + n_sample);
+        return samples[n_sample / 2];
+    }
+
+    // Remove the edges inside one component, and return the new end.
+    Edge *Filter(Edge *first, Edge *last) {
+        auto inside = [&](const Edge &e) {
+            return ds_.Find(e.a) == ds_.Find(e.b);
+        };
+        return ParallelRemoveIf(first, last, inside, pool_);
+    }
+
+    void Run(Edge *first, Edge *last) {
+        if(first == last || count_ == n_ - 1)
+            return;
+        if(size_t(last - first) <= BaseSize()) {
+            Base(first, last);
+            return;
+        }
+        int pivot = Pivot(first, last);
+        Edge *mid = partition(first, last, [&](const Edge &e) {
+            return e.d <= pivot;
+        });
+        if(mid == last) { // `pivot` is the max weight.
+            mid = partition(first, last, [&](const Edge &e) {
+                return e.d < pivot;
+            });
+            if(mid == first) { // All weights are equal.
+                Base(first, last);
+                return;
+            }
+        }
+        Run(first, mid);
+        Run(mid, Filter(mid, last));
+    }
+
+public:
+    // Nodes are in [1, n], or [0, n - 1].
+    FilterKruskal(int n, ThreadPool &pool): n_(n), pool_(pool), ds_(n) {}
+
+    int Run(const vector<Edge> &_edges) {
+        vector<Edge> edges = _edges;
+        Run(edges.data(), edges.data() + edges.size());
+        return sum_;
+    }
+};
@@ -4,31 +4,11 @@
 #include <cassert>
 
 #include <iostream>
-#include <queue>
+#include <random>
 #include <vector>
 using namespace std;
 
-#include "Graph.hpp"
-
-int Prim(const Graph &graph) {
-    priority_queue<Rela> pq;
-    pq.push({1, 0});
-    vector<bool> in_tree(graph.size() + 1);
-
-    int sum = 0;
-    while(!pq.empty()) {
-        int k = pq.top().node_idx;
-        if(!in_tree[k]) {
-            sum += pq.top().dist;
-            in_tree[k] = true;
-        }
-        pq.pop();
-        for(const auto &e: graph.edges(k))
-            if(!in_tree[e.node_idx])
-                pq.push(e);
-    }
-    return sum;
-}
+#include "Prim.hpp"
 
 int main() {
     int n = 6;
@@ -53,4 +33,18 @@ int main() {
         graph.AddEdge(e.a, e.b, e.d);
 
     assert(Prim(graph) == 15);
+    assert(Prim(CSRGraph(graph)) == 15);
+    assert(Prim(CSRGraph(n, edges, false)) == 15);
+    assert(PrimDecreaseKey(graph) == 15);
+
+    // Random graphs, connected or not. Both only span the component of node 1.
+    mt19937 gen(0);
+    for(int t = 0; t < 100; t++) {
+        int n = gen() % 200 + 1;
+        int m = gen() % (n * 4);
+        Graph graph(n, false);
+        for(int i = 0; i < m; i++)
+            graph.AddEdge(gen() % n + 1, gen() % n + 1, gen() % 100);
+        assert(PrimDecreaseKey(graph) == Prim(graph));
+    }
 }
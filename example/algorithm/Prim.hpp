@@ -0,0 +1,61 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+#include "../data_structure/indexed_priority_queue.hpp"
+
+// `GraphType` is `Graph` or `CSRGraph`.
+
+template<typename GraphType>
+int Prim(const GraphType &graph) {
+    priority_queue<Rela> pq;
+    pq.push({1, 0});
+    vector<bool> in_tree(graph.size() + 1);
+
+    int sum = 0;
+    while(!pq.empty()) {
+        int k = pq.top().node_idx;
+        if(!in_tree[k]) {
+            sum += pq.top().dist;
+            in_tree[k] = true;
+        }
+        pq.pop();
+        for(const auto &e: graph.edges(k))
+            if(!in_tree[e.node_idx])
+                pq.push(e);
+    }
+    return sum;
+}
+
+// Prim with decrease-key.
+// `key[i]` is the lightest edge from the tree to node `i`. The heap holds each node at most once.
+// O((V + E)logV)
+template<typename GraphType>
+int PrimDecreaseKey(const GraphType &graph) {
+    vector<int> key(graph.size() + 1, INF);
+    vector<bool> in_tree(graph.size() + 1);
+    indexed_priority_queue<int, greater<int>> pq(graph.size() + 1);
+    key[1] = 0;
+    pq.push(1, 0);
+
+    int sum = 0;
+    while(!pq.empty()) {
+        int k = pq.top_key();
+        sum += pq.top();
+        in_tree[k] = true;
+        pq.pop();
+        for(const auto &e: graph.edges(k)) {
+            if(!in_tree[e.node_idx] && key[e.node_idx] > e.dist) {
+                key[e.node_idx] = e.dist;
+                if(pq.contains(e.node_idx))
+                    pq.update(e.node_idx, e.dist);
+                else
+                    pq.push(e.node_idx, e.dist);
+            }
+        }
+    }
+    return sum;
+}
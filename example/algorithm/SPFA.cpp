@@ -1,65 +1,14 @@
 // SPFA (Shortest Path Faster Algorithm)
 // Bellman–Ford with queue
 
+#include <cassert>
+
 #include <iostream>
-#include <queue>
+#include <random>
 #include <vector>
 using namespace std;
 
-#include "Graph.hpp"
-
-constexpr int INF = 1000000000;
-
-// O(VE)
-bool SPFA(const Graph &graph, int start, vector<int> &dist) {
-    dist = vector<int>(graph.size() + 1, INF);
-    dist[start] = 0;
-    queue<int> q;
-    q.push(start);
-    vector<bool> in_queue(graph.size() + 1);
-    in_queue[start] = true;
-    vector<int> in_count(graph.size() + 1);
-    in_queue[start] = 1;
-
-    while(!q.empty()) {
-        int k = q.front();
-        q.pop();
-        in_queue[k] = false;
-        for(const auto &e: graph.edges(k)) {
-            if(dist[e.node_idx] > dist[k] + e.dist) {
-                dist[e.node_idx] = dist[k] + e.dist;
-                if(!in_queue[e.node_idx]) {
-                    in_count[e.node_idx]++;
-                    // Detect cycles.
-                    if(in_count[e.node_idx] == graph.size())
-                        return true;
-                    q.push(e.node_idx);
-                    in_queue[e.node_idx] = true;
-                }
-            }
-        }
-    }
-    return false;
-}
-
-vector<int> SPFASimple(const Graph &graph, int start) {
-    vector<int> dist(graph.size() + 1, INF);
-    dist[start] = 0;
-    queue<int> q;
-    q.push(start);
-
-    while(!q.empty()) {
-        int k = q.front();
-        q.pop();
-        for(const auto &e: graph.edges(k)) {
-            if(dist[e.node_idx] > dist[k] + e.dist) {
-                dist[e.node_idx] = dist[k] + e.dist;
-                q.push(e.node_idx);
-            }
-        }
-    }
-    return dist;
-}
+#include "SPFA.hpp"
 
 int main() {
     int n = 5;
@@ -272,5 +221,65 @@ int main() {
         }
     }
 
+    cout << "\n";
+
+    {
+        vector<Edge> edges{
+            {1, 2, 4},
+            {1, 4, 2},
+            {2, 3, 4},
+            {2, 4, 1},
+            {3, 4, -100},
+            {4, 5, 7},
+            {5, 3, 3},
+        };
+
+        // Directed.
+        // The same negative circle as above, reported by `SPFAFast()`.
+        Graph graph(n, true);
+        for(const auto &e: edges)
+            graph.AddEdge(e.a, e.b, e.d);
+
+        vector<int> dist, cycle;
+        if(SPFAFast(graph, start, dist, cycle)) {
+            cout << "Negative circle detected:";
+            for(auto k: cycle)
+                cout << " " << k;
+            cout << "\n";
+        }
+    }
+
+    // Random directed graphs with some negative edges. `SPFAFast()` detects the same negative
+    // cycles as `SPFA()`, and gives the same distances otherwise.
+    mt19937 gen(0);
+    for(int t = 0; t < 1000; t++) {
+        int n = gen() % 100 + 1;
+        int m = gen() % (n * 3);
+        Graph graph(n, true);
+        // `weight[a][b]` is the min weight from `a` to `b`.
+        vector<vector<int>> weight(n + 1, vector<int>(n + 1, INF));
+        for(int i = 0; i < m; i++) {
+            int a = gen() % n + 1, b = gen() % n + 1, d = int(gen() % 100) - 10;
+            graph.AddEdge(a, b, d);
+            weight[a][b] = min(weight[a][b], d);
+        }
+        int start = gen() % n + 1;
+
+        vector<int> dist, dist_fast, cycle;
+        bool negative_cycle = SPFA(graph, start, dist);
+        assert(SPFAFast(graph, start, dist_fast, cycle) == negative_cycle);
+        if(!negative_cycle) {
+            assert(dist_fast == dist);
+            continue;
+        }
+        long long cycle_dist = 0;
+        for(size_t i = 0; i < cycle.size(); i++) {
+            int d = weight[cycle[i]][cycle[(i + 1) % cycle.size()]];
+            assert(d != INF);
+            cycle_dist += d;
+        }
+        assert(cycle_dist < 0);
+    }
+
     return 0;
 }
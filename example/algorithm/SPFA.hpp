@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+
+// `GraphType` is `Graph` or `CSRGraph`.
+
+// O(VE)
+template<typename GraphType>
+bool SPFA(const GraphType &graph, int start, vector<int> &dist) {
+    dist = vector<int>(graph.size() + 1, INF);
+    dist[start] = 0;
+    queue<int> q;
+    q.push(start);
+    vector<bool> in_queue(graph.size() + 1);
+    in_queue[start] = true;
+    vector<int> in_count(graph.size() + 1);
+    in_queue[start] = 1;
+
+    while(!q.empty()) {
+        int k = q.front();
+        q.pop();
+        in_queue[k] = false;
+        for(const auto &e: graph.edges(k)) {
+            if(dist[e.node_idx] > dist[k] + e.dist) {
+                dist[e.node_idx] = dist[k] + e.dist;
+                if(!in_queue[e.node_idx]) {
+                    in_count[e.node_idx]++;
+                    // Detect cycles.
+                    if(in_count[e.node_idx] == graph.size())
+                        return true;
+                    q.push(e.node_idx);
+                    in_queue[e.node_idx] = true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+template<typename GraphType>
+vector<int> SPFASimple(const GraphType &graph, int start) {
+    vector<int> dist(graph.size() + 1, INF);
+    dist[start] = 0;
+    queue<int> q;
+    q.push(start);
+
+    while(!q.empty()) {
+        int k = q.front();
+        q.pop();
+        for(const auto &e: graph.edges(k)) {
+            if(dist[e.node_idx] > dist[k] + e.dist) {
+                dist[e.node_idx] = dist[k] + e.dist;
+                q.push(e.node_idx);
+            }
+        }
+    }
+    return dist;
+}
+
+// SPFA with SLF (Small Label First) and LLL (Large Label Last) queue ordering, and early negative
+// cycle detection.
+// SLF: an improved node goes to the front of the queue if it's closer than the front node.
+// LLL: the front node is moved to the back while it's farther than the average of the queue.
+// Both make nodes be popped closer to distance order, so fewer nodes are improved again.
+// `parent[i]` is the node which improved node `i` last. A cycle in this parent graph is always a
+// negative cycle. The parent graph is searched for cycles once every V relaxations, in O(V), so a
+// negative cycle is usually reported soon after it's relaxed around, instead of after some node is
+// queued V times, which is O(VE).
+// Return true and the negative cycle, `cycle[0] -> cycle[1] -> ... -> cycle[0]`, if detected.
+template<typename GraphType>
+bool SPFAFast(const GraphType &graph, int start, vector<int> &dist, vector<int> &cycle) {
+    int n = graph.size() + 1;
+    dist = vector<int>(n, INF);
+    dist[start] = 0;
+    vector<int> parent(n, -1);
+    deque<int> q;
+    q.push_back(start);
+    vector<bool> in_queue(n);
+    in_queue[start] = true;
+    long long queue_sum = 0; // Sum of `dist` in the queue, for LLL.
+
+    // Walk the parent graph from each node, marking nodes with the index of the walk.
+    // Reaching a node marked by the same walk means a cycle.
+    vector<int> mark(n);
+    int walk = 0;
+    auto find_cycle = [&] {
+        for(int i = 0; i < n; i++) {
+            walk++;
+            int k = i;
+            for(; k != -1 && !mark[k]; k = parent[k])
+                mark[k] = walk;
+            if(k != -1 && mark[k] == walk) {
+                for(int j = k; cycle.empty() || j != k; j = parent[j])
+                    cycle.push_back(j);
+                reverse(cycle.begin(), cycle.end());
+                return true;
+            }
+        }
+        fill(mark.begin(), mark.end(), 0);
+        walk = 0;
+        return false;
+    };
+
+    cycle.clear();
+    int relaxations = 0;
+    while(!q.empty()) {
+        // LLL.
+        while(q.size() > 1 && (long long)dist[q.front()] * (long long)q.size() > queue_sum) {
+            q.push_back(q.front());
+            q.pop_front();
+        }
+        int k = q.front();
+        q.pop_front();
+        in_queue[k] = false;
+        queue_sum -= dist[k];
+        for(const auto &e: graph.edges(k)) {
+            int new_dist = dist[k] + e.dist;
+            if(dist[e.node_idx] > new_dist) {
+                if(in_queue[e.node_idx])
+                    queue_sum -= dist[e.node_idx] - new_dist;
+                dist[e.node_idx] = new_dist;
+                parent[e.node_idx] = k;
+                if(++relaxations == n) {
+                    relaxations = 0;
+                    if(find_cycle())
+                        return true;
+                }
+                if(!in_queue[e.node_idx]) {
+                    // SLF.
+                    if(!q.empty() && new_dist < dist[q.front()])
+                        q.push_front(e.node_idx);
+                    else
+                        q.push_back(e.node_idx);
+                    in_queue[e.node_idx] = true;
+                    queue_sum += new_dist;
+                }
+            }
+        }
+    }
+    return false;
+}
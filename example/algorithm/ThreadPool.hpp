@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// A fixed-size pool of worker threads.
+// `ParallelFor()` runs on the workers and the calling thread, so a pool of `size` workers uses
+// `size + 1` threads, and a pool of 0 workers runs everything on the calling thread.
+class ThreadPool {
+    vector<thread> workers_;
+    queue<function<void()>> tasks_;
+    mutex mutex_;
+    condition_variable cv_;
+    bool stop_ = false;
+
+public:
+    explicit ThreadPool(int size = int(thread::hardware_concurrency()) - 1) {
+        for(int i = 0; i < size; i++)
+            workers_.emplace_back([this] {
+                while(true) {
+                    function<void()> task;
+                    {
+                        unique_lock<mutex> lock(mutex_);
+                        cv_.wait(lock, [this] {
+                            return stop_ || !tasks_.empty();
+                        });
+                        if(stop_ && tasks_.empty())
+                            return;
+                        task = move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for(auto &worker: workers_)
+            worker.join();
+    }
+
+    int size() const {
+        return workers_.size();
+    }
+
+    void Submit(function<void()> task) {
+        {
+            lock_guard<mutex> lock(mutex_);
+            tasks_.push(move(task));
+        }
+        cv_.notify_one();
+    }
+
+    // Run `f(i)` for each i in [0, n) and wait for all of them.
+    // The calling thread takes indexes too, and waits for indexes instead of tasks, so calling
+    // `ParallelFor()` from inside a task doesn't deadlock.
+    template<typename F>
+    void ParallelFor(int n, F f) {
+        struct State {
+            atomic<int> next{0}, done{0};
+            mutex done_mutex;
+            condition_variable done_cv;
+        };
+        auto state = make_shared<State>();
+        auto run = [state, n, &f] {
+            int count = 0;
+            for(int i; (i = state->next++) < n; count++)
+                f(i);
+            if(count && state->done.fetch_add(count) + count == n) {
+                lock_guard<mutex> lock(state->done_mutex);
+                state->done_cv.notify_all();
+            }
+        };
+        for(int i = 0, tasks = min(size(), n - 1); i < tasks; i++)
+            Submit(run);
+        run();
+        unique_lock<mutex> lock(state->done_mutex);
+        state->done_cv.wait(lock, [&] {
+            return state->done == n;
+        });
+    }
+};
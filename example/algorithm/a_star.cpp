@@ -1,8 +1,11 @@
+#include <cassert>
 #include <iostream>
-#include <queue>
+#include <random>
 #include <vector>
 using namespace std;
 
+#include "a_star.hpp"
+
 constexpr int row = 15, col = 20;
 // clang-format off
 constexpr int map[row][col] = { // `1` is obstacle.
@@ -22,64 +25,53 @@ constexpr int map[row][col] = { // `1` is obstacle.
     {0,1,0,0,0,0,1,0,0,0,0,0,0,1,0,1,0,0,0,1},
     {0,0,1,0,1,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0},
 };
-constexpr int step[4][2] = {
-    {-1, 0},
-    { 1, 0},
-    { 0,-1},
-    { 0, 1},
-};
 // clang-format on
 
-struct Node {
-    int x, y, h0, h1;
-    bool operator<(const Node &node) const {
-        return h0 + h1 > node.h0 + node.h1;
-    }
-};
-
-bool Valid(int x, int y) {
-    return x >= 0 && x < row && y >= 0 && y < col;
-}
-
-int Heuristic(int x, int y, int x1, int y1) {
-    return std::abs(x - x1) + std::abs(y - y1);
+GridMap ExampleMap() {
+    GridMap grid(row, col);
+    for(int x = 0; x < row; x++)
+        for(int y = 0; y < col; y++)
+            grid.Set(x, y, map[x][y]);
+    return grid;
 }
 
-bool AStar(int x0, int y0, int x1, int y1, int &dist) {
-    if(map[x0][y0] || map[x1][y1])
-        return false;
-
-    priority_queue<Node> pq;
-    pq.push({x0, y0, 0, Heuristic(x0, y0, x1, y1)});
-    vector<vector<int>> visited(row, vector<int>(col));
-    visited[x0][y0] = true;
-
-    while(!pq.empty()) {
-        Node node = pq.top();
-        if(node.x == x1 && node.y == y1) {
-            dist = node.h0;
-            return true;
-        }
-        pq.pop();
-        visited[node.x][node.y] = true;
-        for(int i = 0; i < 4; i++) {
-            int x = node.x + step[i][0];
-            int y = node.y + step[i][1];
-            if(Valid(x, y) && !map[x][y] && !visited[x][y])
-                pq.push({x, y, node.h0 + 1, Heuristic(x, y, x1, y1)});
-        }
+// Cost of `path` in `mode`, or -1 if it isn't a valid path on `grid`.
+int PathCost(const GridMap &grid, const vector<Point> &path, GridAStar::Mode mode) {
+    int cost = 0;
+    for(size_t i = 0; i < path.size(); i++) {
+        auto [x, y] = path[i];
+        if(!grid.Free(x, y))
+            return -1;
+        if(i == 0)
+            continue;
+        int dx = x - path[i - 1].x, dy = y - path[i - 1].y;
+        if(abs(dx) > 1 || abs(dy) > 1 || (!dx && !dy))
+            return -1;
+        if(dx && dy) {
+            if(mode == GridAStar::Mode::Four || !grid.Free(x - dx, y) || !grid.Free(x, y - dy))
+                return -1;
+            cost += GridAStar::diagonal_cost;
+        } else
+            cost += GridAStar::straight_cost;
     }
-    return false;
+    return cost;
 }
 
 int main() {
-    int dist;
+    GridMap grid = ExampleMap();
+    GridAStar a_star(grid);
+    int cost;
+    vector<Point> path;
 
     {
         int x0 = 0, y0 = 0, x1 = row - 1, y1 = col - 1;
-        if(AStar(x0, y0, x1, y1, dist))
-            cout << "Shortest distance: " << dist << endl; // Path exists with distance 33.
-        else
+        if(a_star.Search({x0, y0}, {x1, y1}, GridAStar::Mode::Four, cost, path)) {
+            // Path exists with distance 33.
+            cout << "Shortest distance: " << cost / GridAStar::straight_cost << endl;
+            assert(cost == 33 * GridAStar::straight_cost);
+            assert(int(path.size()) == 34);
+            assert(PathCost(grid, path, GridAStar::Mode::Four) == cost);
+        } else
             cout << "No path exists." << endl;
     }
 
@@ -87,11 +79,86 @@ int main() {
 
     {
         int x0 = 0, y0 = 0, x1 = row - 1, y1 = 0;
-        if(AStar(x0, y0, x1, y1, dist))
-            cout << "Shortest distance: " << dist << endl;
+        if(a_star.Search({x0, y0}, {x1, y1}, GridAStar::Mode::Four, cost, path))
+            cout << "Shortest distance: " << cost / GridAStar::straight_cost << endl;
         else
             cout << "No path exists." << endl; // No path exists.
     }
 
+    cout << endl;
+
+    {
+        int x0 = 0, y0 = 0, x1 = row - 1, y1 = col - 1;
+        int jump_cost;
+        vector<Point> jump_path;
+        bool found = a_star.Search({x0, y0}, {x1, y1}, GridAStar::Mode::Eight, cost, path);
+        bool jump_found =
+            a_star.Search({x0, y0}, {x1, y1}, GridAStar::Mode::JumpPoint, jump_cost, jump_path);
+        assert(found && jump_found && cost == jump_cost);
+        cout << "8-connected path with cost " << cost << ":";
+        for(auto [x, y]: path)
+            cout << " (" << x << "," << y << ")";
+        cout << endl;
+    }
+
+    // Random maps. Four-connected against BFS, jump point search against 8-connected A*.
+    mt19937 gen(0);
+    for(int t = 0; t < 300; t++) {
+        int n = gen() % 40 + 1, m = gen() % 40 + 1;
+        int obstacle = gen() % 40;
+        GridMap random_grid(n, m);
+        for(int x = 0; x < n; x++)
+            for(int y = 0; y < m; y++)
+                random_grid.Set(x, y, int(gen() % 100) < obstacle);
+        GridAStar random_a_star(random_grid);
+        for(int q = 0; q < 20; q++) {
+            Point start{int(gen() % n), int(gen() % m)}, goal{int(gen() % n), int(gen() % m)};
+
+            vector<int> bfs(n * m, -1);
+            vector<Point> bfs_queue;
+            if(random_grid.Free(start.x, start.y)) {
+                bfs[random_grid.Index(start.x, start.y)] = 0;
+                bfs_queue.push_back(start);
+            }
+            for(size_t i = 0; i < bfs_queue.size(); i++) {
+                auto [x, y] = bfs_queue[i];
+                for(auto [dx, dy]: {pair{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+                    int nx = x + dx, ny = y + dy;
+                    if(random_grid.Free(nx, ny) && bfs[random_grid.Index(nx, ny)] == -1) {
+                        bfs[random_grid.Index(nx, ny)] = bfs[random_grid.Index(x, y)] + 1;
+                        bfs_queue.push_back({nx, ny});
+                    }
+                }
+            }
+            int expected = random_grid.Free(goal.x, goal.y) ? bfs[random_grid.Index(goal.x, goal.y)]
+                                                            : -1;
+
+            bool found = random_a_star.Search(start, goal, GridAStar::Mode::Four, cost, path);
+            assert(found == (expected != -1));
+            if(found) {
+                assert(cost == expected * GridAStar::straight_cost);
+                assert(path.front() == start && path.back() == goal);
+                assert(PathCost(random_grid, path, GridAStar::Mode::Four) == cost);
+            }
+
+            int eight_cost = -1;
+            bool eight_found =
+                random_a_star.Search(start, goal, GridAStar::Mode::Eight, eight_cost, path);
+            assert(eight_found == found);
+            if(eight_found) {
+                assert(path.front() == start && path.back() == goal);
+                assert(PathCost(random_grid, path, GridAStar::Mode::Eight) == eight_cost);
+            }
+            bool jump_found =
+                random_a_star.Search(start, goal, GridAStar::Mode::JumpPoint, cost, path);
+            assert(jump_found == found);
+            if(jump_found) {
+                assert(cost == eight_cost);
+                assert(path.front() == start && path.back() == goal);
+                assert(PathCost(random_grid, path, GridAStar::Mode::Eight) == cost);
+            }
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <istream>
+#include <queue>
+#include <string>
+#include <vector>
+using namespace std;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// A grid with 1 bit per cell, `1` is obstacle.
+// Cells are `(x, y)` with `x` in [0, row) and `y` in [0, col), as `map[x][y]` in "a_star.cpp".
+class GridMap {
+    int row_, col_;
+    vector<uint64_t> bits_;
+
+public:
+    GridMap(int row, int col): row_(row), col_(col), bits_((size_t(row) * col + 63) / 64) {}
+
+    // One line per row. '.', '0', 'G' and 'S' are free, other characters are obstacles.
+    // The "map" section of Moving AI benchmark maps (https://movingai.com/benchmarks/) is accepted.
+    static GridMap Load(istream &is) {
+        vector<string> lines;
+        size_t col = 0;
+        for(string line; getline(is, line);) {
+            if(!line.empty() && line.back() == '\r')
+                line.pop_back();
+            lines.push_back(line);
+            col = max(col, line.size());
+        }
+        GridMap grid(lines.size(), col);
+        for(size_t x = 0; x < lines.size(); x++)
+            for(size_t y = 0; y < col; y++) {
+                char c = y < lines[x].size() ? lines[x][y] : '@';
+                grid.Set(x, y, !(c == '.' || c == '0' || c == 'G' || c == 'S'));
+            }
+        return grid;
+    }
+
+    int row() const {
+        return row_;
+    }
+    int col() const {
+        return col_;
+    }
+    int Index(int x, int y) const {
+        return x * col_ + y;
+    }
+    bool Valid(int x, int y) const {
+        return x >= 0 && x < row_ && y >= 0 && y < col_;
+    }
+    // Out of the grid is obstacle.
+    bool Free(int x, int y) const {
+        if(!Valid(x, y))
+            return false;
+        size_t i = Index(x, y);
+        return !(bits_[i >> 6] >> (i & 63) & 1);
+    }
+    // Obstacle bits of cells (x, y), (x, y + 1), ..., (x, y + 63), from the lowest bit.
+    // Out of the grid is obstacle.
+    uint64_t Bits(int x, int y) const {
+        int begin = max(y, 0), end = min(y + 64, col_);
+        if(x < 0 || x >= row_ || begin >= end)
+            return ~uint64_t(0);
+        size_t i = Index(x, begin), w = i >> 6, s = i & 63;
+        uint64_t bits = bits_[w] >> s;
+        if(s && w + 1 < bits_.size())
+            bits |= bits_[w + 1] << (64 - s);
+        int len = end - begin;
+        uint64_t valid = (len == 64 ? ~uint64_t(0) : (uint64_t(1) << len) - 1) << (begin - y);
+        return (bits << (begin - y) & valid) | ~valid;
+    }
+    void Set(int x, int y, bool obstacle) {
+        size_t i = Index(x, y);
+        if(obstacle)
+            bits_[i >> 6] |= uint64_t(1) << (i & 63);
+        else
+            bits_[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+};
+
+struct Point {
+    int x, y;
+    bool operator==(const Point &p) const {
+        return x == p.x && y == p.y;
+    }
+};
+
+// A* on a `GridMap`.
+// Modes:
+//     Four:      4-connectivity. Each step costs `straight_cost`.
+//     Eight:     8-connectivity. Diagonal steps cost `diagonal_cost`, and don't cut corners, i.e.
+//                both cells beside a diagonal step must be free.
+//     JumpPoint: Jump Point Search. Same paths costs as `Eight`, but only jump points are pushed to
+//                the open list. Straight and diagonal runs of cells are scanned without pushing.
+// Straight jumps scan 64 cells at a time from the bits of the grid and its transpose.
+// All per-query storage is kept in the object and reused by the next query. g-values are valid only
+// if stamped with the current query, and the closed bitmap is cleared word by word from the list of
+// touched words, so a query costs only what it touches, not the grid size.
+// Use one object per thread.
+class GridAStar {
+public:
+    enum class Mode { Four, Eight, JumpPoint };
+
+    static constexpr int straight_cost = 5;
+    static constexpr int diagonal_cost = 7; // About `straight_cost * sqrt(2)`.
+
+private:
+    struct Node {
+        int f, g, index;
+        bool operator<(const Node &node) const {
+            // Min f first. For the same f, max g first, i.e. closer to the goal.
+            return f > node.f || (f == node.f && g < node.g);
+        }
+    };
+
+    const GridMap &map_;
+    GridMap transposed_; // Cell (y, x) is cell (x, y) of `map_`, for scanning along x.
+    Mode mode_;
+    Point goal_;
+
+    vector<int> g_;
+    vector<int> parent_;
+    vector<uint32_t> stamp_;
+    uint32_t query_ = 0;
+    vector<uint64_t> closed_;
+    vector<int> closed_touched_;
+    vector<Node> open_;
+
+    bool Closed(int i) const {
+        return closed_[i >> 6] >> (i & 63) & 1;
+    }
+    void Close(int i) {
+        if(!closed_[i >> 6])
+            closed_touched_.push_back(i >> 6);
+        closed_[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+
+    int Heuristic(int x, int y) const {
+        int dx = abs(x - goal_.x), dy = abs(y - goal_.y);
+        if(mode_ == Mode::Four)
+            return (dx + dy) * straight_cost;
+        // Octile distance.
+        return max(dx, dy) * straight_cost + min(dx, dy) * (diagonal_cost - straight_cost);
+    }
+
+    void Push(int x, int y, int g, int parent) {
+        int i = map_.Index(x, y);
+        if(Closed(i) || (stamp_[i] == query_ && g_[i] <= g))
+            return;
+        stamp_[i] = query_;
+        g_[i] = g;
+        parent_[i] = parent;
+        open_.push_back({g + Heuristic(x, y), g, i});
+        push_heap(open_.begin(), open_.end());
+    }
+
+    static int StepCost(int dx, int dy) {
+        return dx && dy ? diagonal_cost : straight_cost;
+    }
+
+    // A diagonal step from (x, y) by (dx, dy) doesn't cut corners.
+    bool DiagonalFree(int x, int y, int dx, int dy) const {
+        return map_.Free(x + dx, y) && map_.Free(x, y + dy);
+    }
+
+    void ExpandNeighbors(int x, int y, int g, int i) {
+        static constexpr int step[8][2] = {
+            {-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        int n_step = mode_ == Mode::Four ? 4 : 8;
+        for(int s = 0; s < n_step; s++) {
+            int dx = step[s][0], dy = step[s][1];
+            if(!map_.Free(x + dx, y + dy) || (dx && dy && !DiagonalFree(x, y, dx, dy)))
+                continue;
+            Push(x + dx, y + dy, g + StepCost(dx, dy), i);
+        }
+    }
+
+    static int CountrZero(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return i;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+    static int CountlZero(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return 63 - i;
+#else
+        return __builtin_clzll(x);
+#endif
+    }
+
+    // `Jump()` along y on `grid`, i.e. `dx` is 0. Forced neighbors are on rows x - 1 and x + 1.
+    // Each window of 64 cells is checked at once: the first cell which is an obstacle, has a forced
+    // neighbor, or is the goal.
+    static bool JumpStraight(const GridMap &grid, int x, int &y, int dy, Point goal) {
+        auto forced = [&](int p, int prev) {
+            uint64_t bits = (~grid.Bits(x - 1, p) & grid.Bits(x - 1, prev))
+                            | (~grid.Bits(x + 1, p) & grid.Bits(x + 1, prev));
+            if(x == goal.x && goal.y >= p && goal.y < p + 64)
+                bits |= uint64_t(1) << (goal.y - p);
+            return bits;
+        };
+        if(dy > 0) {
+            for(int p = y + 1;; p += 64) {
+                uint64_t blocked = grid.Bits(x, p), stop = blocked | forced(p, p - 1);
+                if(stop) {
+                    int t = CountrZero(stop);
+                    y = p + t;
+                    return !(blocked >> t & 1);
+                }
+            }
+        } else {
+            for(int p = y - 64;; p -= 64) {
+                uint64_t blocked = grid.Bits(x, p), stop = blocked | forced(p, p + 1);
+                if(stop) {
+                    int t = 63 - CountlZero(stop);
+                    y = p + t;
+                    return !(blocked >> t & 1);
+                }
+            }
+        }
+    }
+
+    // Move from (x, y) by (dx, dy) until a jump point. Return whether one is found, and set (x, y)
+    // to it. A jump point is the goal, or a cell with a forced neighbor, i.e. a neighbor which has
+    // no optimal path avoiding this cell, or a cell from which a straight jump finds one.
+    bool Jump(int &x, int &y, int dx, int dy) const {
+        if(!dx)
+            return JumpStraight(map_, x, y, dy, goal_);
+        if(!dy)
+            return JumpStraight(transposed_, y, x, dx, {goal_.y, goal_.x});
+        while(true) {
+            if(!DiagonalFree(x, y, dx, dy))
+                return false;
+            x += dx;
+            y += dy;
+            if(!map_.Free(x, y))
+                return false;
+            if(x == goal_.x && y == goal_.y)
+                return true;
+            int x1 = x, y1 = y, x2 = x, y2 = y;
+            if(Jump(x1, y1, dx, 0) || Jump(x2, y2, 0, dy))
+                return true;
+        }
+    }
+
+    void JumpFrom(int x, int y, int g, int i, int dx, int dy) {
+        int jx = x, jy = y;
+        if(Jump(jx, jy, dx, dy))
+            Push(jx, jy, g + max(abs(jx - x), abs(jy - y)) * StepCost(dx, dy), i);
+    }
+
+    // Only the directions which may lead to forced neighbors, i.e. the pruned neighbors.
+    void ExpandJumpPoints(int x, int y, int g, int i) {
+        int p = parent_[i];
+        if(p == -1) {
+            for(int dx = -1; dx <= 1; dx++)
+                for(int dy = -1; dy <= 1; dy++)
+                    if(dx || dy)
+                        JumpFrom(x, y, g, i, dx, dy);
+            return;
+        }
+        int px = p / map_.col(), py = p % map_.col();
+        int dx = (x > px) - (x < px), dy = (y > py) - (y < py);
+        if(dx && dy) {
+            JumpFrom(x, y, g, i, dx, 0);
+            JumpFrom(x, y, g, i, 0, dy);
+            JumpFrom(x, y, g, i, dx, dy);
+        } else if(dx) {
+            JumpFrom(x, y, g, i, dx, 0);
+            for(int side: {-1, 1})
+                if(map_.Free(x, y + side)) {
+                    JumpFrom(x, y, g, i, 0, side);
+                    JumpFrom(x, y, g, i, dx, side);
+                }
+        } else {
+            JumpFrom(x, y, g, i, 0, dy);
+            for(int side: {-1, 1})
+                if(map_.Free(x + side, y)) {
+                    JumpFrom(x, y, g, i, side, 0);
+                    JumpFrom(x, y, g, i, side, dy);
+                }
+        }
+    }
+
+    // Walk the parents back from the goal. Jump points are joined by straight or diagonal runs.
+    void BuildPath(int goal, vector<Point> &path) const {
+        path.clear();
+        for(int i = goal; i != -1; i = parent_[i]) {
+            int x = i / map_.col(), y = i % map_.col();
+            path.push_back({x, y});
+            if(parent_[i] == -1)
+                break;
+            int px = parent_[i] / map_.col(), py = parent_[i] % map_.col();
+            int dx = (px > x) - (px < x), dy = (py > y) - (py < y);
+            for(x += dx, y += dy; x != px || y != py; x += dx, y += dy)
+                path.push_back({x, y});
+        }
+        reverse(path.begin(), path.end());
+    }
+
+public:
+    explicit GridAStar(const GridMap &map)
+        : map_(map)
+        , transposed_(map.col(), map.row())
+        , g_(size_t(map.row()) * map.col())
+        , parent_(size_t(map.row()) * map.col())
+        , stamp_(size_t(map.row()) * map.col())
+        , closed_((size_t(map.row()) * map.col() + 63) / 64) {
+        for(int x = 0; x < map.row(); x++)
+            for(int y = 0; y < map.col(); y++)
+                transposed_.Set(y, x, !map.Free(x, y));
+    }
+
+    // Return whether a path exists. If so, `cost` is its cost, and `path` is its cells from `start`
+    // to `goal`.
+    bool Search(Point start, Point goal, Mode mode, int &cost, vector<Point> &path) {
+        if(!map_.Free(start.x, start.y) || !map_.Free(goal.x, goal.y))
+            return false;
+
+        mode_ = mode;
+        goal_ = goal;
+        if(++query_ == 0) { // Wrapped around. Stamps of the earliest queries would be valid again.
+            fill(stamp_.begin(), stamp_.end(), 0);
+            query_ = 1;
+        }
+        for(int w: closed_touched_)
+            closed_[w] = 0;
+        closed_touched_.clear();
+        open_.clear();
+
+        Push(start.x, start.y, 0, -1);
+        while(!open_.empty()) {
+            pop_heap(open_.begin(), open_.end());
+            Node node = open_.back();
+            open_.pop_back();
+            if(Closed(node.index) || node.g != g_[node.index]) // Stale.
+                continue;
+            Close(node.index);
+            int x = node.index / map_.col(), y = node.index % map_.col();
+            if(x == goal.x && y == goal.y) {
+                cost = node.g;
+                BuildPath(node.index, path);
+                return true;
+            }
+            if(mode_ == Mode::JumpPoint)
+                ExpandJumpPoints(x, y, node.g, node.index);
+            else
+                ExpandNeighbors(x, y, node.g, node.index);
+        }
+        return false;
+    }
+};
@@ -0,0 +1,193 @@
+// `GridAStar` on 4096x4096 random maps and room maps: 4-connected, 8-connected and jump point
+// search, and the original `AStar()` of "a_star.cpp" for reference.
+
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "a_star.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 4096;
+constexpr int n_query = 8;
+
+// `n * n` cells, each is obstacle with probability `obstacle` percent.
+const GridMap &RandomMap(int obstacle) {
+    static map<int, GridMap> cache;
+    auto it = cache.find(obstacle);
+    if(it == cache.end()) {
+        mt19937 gen(obstacle);
+        GridMap grid(n, n);
+        for(int x = 0; x < n; x++)
+            for(int y = 0; y < n; y++)
+                grid.Set(x, y, int(gen() % 100) < obstacle);
+        it = cache.emplace(obstacle, move(grid)).first;
+    }
+    return it->second;
+}
+
+// `n * n` cells split into 64x64 rooms by walls, with a door of width 8 at a random place of each
+// wall of each room. Large open areas, where jump point search skips the most.
+const GridMap &RoomMap() {
+    static GridMap grid = [] {
+        mt19937 gen(0);
+        GridMap grid(n, n);
+        for(int x = 0; x < n; x += 64)
+            for(int y = 0; y < n; y++) {
+                grid.Set(x, y, true);
+                grid.Set(y, x, true);
+            }
+        for(int x = 0; x < n; x += 64)
+            for(int y = 0; y < n; y += 64) {
+                int door = gen() % 48 + 8;
+                for(int i = door; i < door + 8; i++)
+                    grid.Set(x, y + i, false);
+                door = gen() % 48 + 8;
+                for(int i = door; i < door + 8; i++)
+                    grid.Set(x + i, y, false);
+            }
+        return grid;
+    }();
+    return grid;
+}
+
+// Free cells in opposite quarters, so paths cross most of the map.
+vector<pair<Point, Point>> Queries(const GridMap &grid) {
+    mt19937 gen(0);
+    auto random_free = [&](int low, int high) {
+        while(true) {
+            Point p{int(gen() % (high - low)) + low, int(gen() % (high - low)) + low};
+            if(grid.Free(p.x, p.y))
+                return p;
+        }
+    };
+    vector<pair<Point, Point>> queries;
+    for(int i = 0; i < n_query; i++)
+        queries.push_back({random_free(0, n / 4), random_free(n / 4 * 3, n)});
+    return queries;
+}
+
+// The original `AStar()` of "a_star.cpp", on a `GridMap`: a visited array per call, and a cell may
+// be pushed once per neighbor.
+bool AStarOriginal(const GridMap &grid, Point start, Point goal, int &dist) {
+    struct Node {
+        int x, y, h0, h1;
+        bool operator<(const Node &node) const {
+            return h0 + h1 > node.h0 + node.h1;
+        }
+    };
+    constexpr int step[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    auto heuristic = [&](int x, int y) {
+        return abs(x - goal.x) + abs(y - goal.y);
+    };
+
+    if(!grid.Free(start.x, start.y) || !grid.Free(goal.x, goal.y))
+        return false;
+
+    priority_queue<Node> pq;
+    pq.push({start.x, start.y, 0, heuristic(start.x, start.y)});
+    vector<vector<int>> visited(grid.row(), vector<int>(grid.col()));
+    visited[start.x][start.y] = true;
+
+    while(!pq.empty()) {
+        Node node = pq.top();
+        if(node.x == goal.x && node.y == goal.y) {
+            dist = node.h0;
+            return true;
+        }
+        pq.pop();
+        visited[node.x][node.y] = true;
+        for(int i = 0; i < 4; i++) {
+            int x = node.x + step[i][0];
+            int y = node.y + step[i][1];
+            if(grid.Free(x, y) && !visited[x][y])
+                pq.push({x, y, node.h0 + 1, heuristic(x, y)});
+        }
+    }
+    return false;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the obstacle percentage. Items are queries.
+
+static void BM_AStarOriginal(benchmark::State &state) {
+    const GridMap &grid = RandomMap(state.range(0));
+    auto queries = Queries(grid);
+    int dist;
+    for(auto _: state)
+        for(auto [start, goal]: queries)
+            benchmark::DoNotOptimize(AStarOriginal(grid, start, goal, dist));
+    state.SetItemsProcessed(state.iterations() * n_query);
+}
+BENCHMARK(BM_AStarOriginal)->Arg(1)->Arg(10)->Arg(30)->Unit(benchmark::kMillisecond);
+
+void RunGridAStar(benchmark::State &state, const GridMap &grid, GridAStar::Mode mode) {
+    auto queries = Queries(grid);
+    GridAStar a_star(grid);
+    int cost;
+    vector<Point> path;
+    for(auto _: state)
+        for(auto [start, goal]: queries)
+            benchmark::DoNotOptimize(a_star.Search(start, goal, mode, cost, path));
+    state.SetItemsProcessed(state.iterations() * n_query);
+}
+
+static void BM_GridAStar(benchmark::State &state, GridAStar::Mode mode) {
+    RunGridAStar(state, RandomMap(state.range(0)), mode);
+}
+BENCHMARK_CAPTURE(BM_GridAStar, Four, GridAStar::Mode::Four)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GridAStar, Eight, GridAStar::Mode::Eight)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GridAStar, JumpPoint, GridAStar::Mode::JumpPoint)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_GridAStarRooms(benchmark::State &state, GridAStar::Mode mode) {
+    RunGridAStar(state, RoomMap(), mode);
+}
+BENCHMARK_CAPTURE(BM_GridAStarRooms, Four, GridAStar::Mode::Four)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GridAStarRooms, Eight, GridAStar::Mode::Eight)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GridAStarRooms, JumpPoint, GridAStar::Mode::JumpPoint)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------
+Benchmark                            Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------
+BM_AStarOriginal/1                2960 ms         2913 ms            1 items_per_second=2.74585/s
+BM_AStarOriginal/10               3695 ms         3648 ms            1 items_per_second=2.19319/s
+BM_AStarOriginal/30               9694 ms         9592 ms            1 items_per_second=0.834014/s
+BM_GridAStar/Four/1               96.7 ms         95.8 ms            7 items_per_second=83.5221/s
+BM_GridAStar/Four/10              1060 ms         1047 ms            1 items_per_second=7.63794/s
+BM_GridAStar/Four/30              4537 ms         4448 ms            1 items_per_second=1.7985/s
+BM_GridAStar/Eight/1              94.9 ms         90.8 ms            9 items_per_second=88.1281/s
+BM_GridAStar/Eight/10             7854 ms         7576 ms            1 items_per_second=1.05591/s
+BM_GridAStar/Eight/30            16203 ms        15720 ms            1 items_per_second=0.508912/s
+BM_GridAStar/JumpPoint/1           459 ms          456 ms            2 items_per_second=17.5538/s
+BM_GridAStar/JumpPoint/10         6766 ms         6612 ms            1 items_per_second=1.2099/s
+BM_GridAStar/JumpPoint/30        12116 ms        11968 ms            1 items_per_second=0.668468/s
+BM_GridAStarRooms/Four           11090 ms        10966 ms            1 items_per_second=0.729528/s
+BM_GridAStarRooms/Eight           9999 ms         9880 ms            1 items_per_second=0.809738/s
+BM_GridAStarRooms/JumpPoint        223 ms          218 ms            3 items_per_second=36.7253/s
+
+*/
@@ -0,0 +1,81 @@
+// Batch shortest paths
+// Many-to-many `Dijkstra()` across a thread pool.
+
+#include <cassert>
+
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "Dijkstra.hpp"
+#include "batch_shortest_paths.hpp"
+
+int main() {
+    int n = 5;
+    struct Edge {
+        int a, b, d;
+    };
+    vector<Edge> edges{
+        {1, 2, 4},
+        {1, 4, 2},
+        {2, 3, 4},
+        {2, 4, 1},
+        {3, 4, 1},
+        {4, 5, 7},
+        {5, 3, 3},
+    };
+
+    ThreadPool pool(3);
+
+    {
+        Graph graph(n, false);
+        for(const auto &e: edges)
+            graph.AddEdge(e.a, e.b, e.d);
+
+        vector<int> sources{1, 2, 3, 4, 5}, targets{1, 3, 5};
+        DistTable table = DijkstraBatch(graph, pool).Run(sources, targets);
+        for(int i = 0; i < table.rows(); i++) {
+            for(int j = 0; j < table.cols(); j++)
+                cout << table[i][j] << " ";
+            cout << "\n";
+            for(int j = 0; j < table.cols(); j++)
+                assert(table[i][j] == Dijkstra(graph, sources[i])[targets[j]]);
+        }
+    }
+
+    // Random graphs, directed or not, connected or not, with and without targets, reusing one
+    // `DijkstraBatch` for several batches.
+    mt19937 gen(0);
+    for(int t = 0; t < 100; t++) {
+        int n = gen() % 500 + 1;
+        int m = gen() % (n * 4);
+        Graph graph(n, t % 2);
+        for(int i = 0; i < m; i++)
+            graph.AddEdge(gen() % n + 1, gen() % n + 1, gen() % 100);
+        CSRGraph csr_graph(graph);
+        DijkstraBatch<CSRGraph> batch(csr_graph, pool);
+
+        for(int b = 0; b < 3; b++) {
+            vector<int> sources(gen() % 50), targets(b == 0 ? 0 : gen() % 20 + 1);
+            for(auto &s: sources)
+                s = gen() % n + 1;
+            for(auto &t: targets)
+                t = gen() % n + 1; // May repeat.
+            DistTable table = batch.Run(sources, targets);
+            assert(table.rows() == int(sources.size()));
+            for(size_t i = 0; i < sources.size(); i++) {
+                vector<int> dist = Dijkstra(graph, sources[i]);
+                if(targets.empty()) {
+                    assert(table.cols() == n + 1);
+                    for(int k = 0; k <= n; k++)
+                        assert(table[i][k] == dist[k]);
+                } else
+                    for(size_t j = 0; j < targets.size(); j++)
+                        assert(table[i][j] == dist[targets[j]]);
+            }
+        }
+    }
+
+    return 0;
+}
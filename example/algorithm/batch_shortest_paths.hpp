@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// Distances from `rows()` sources to `cols()` targets, row-major in one allocation.
+class DistTable {
+    int rows_, cols_;
+    vector<int> data_;
+
+public:
+    DistTable(int rows = 0, int cols = 0): rows_(rows), cols_(cols), data_(size_t(rows) * cols) {}
+
+    int rows() const {
+        return rows_;
+    }
+    int cols() const {
+        return cols_;
+    }
+    int *operator[](int i) {
+        return &data_[size_t(i) * cols_];
+    }
+    const int *operator[](int i) const {
+        return &data_[size_t(i) * cols_];
+    }
+};
+
+// Many-to-many shortest paths: one `Dijkstra()` per source, run across a `ThreadPool`.
+// Each thread owns scratch arrays which are reused by all of its queries. A node's `dist` is valid
+// only if its stamp is the current query's, so nothing is cleared between queries. With targets,
+// a query stops as soon as all targets are settled.
+// Same distances as `Dijkstra()`, with `INF` for unreachable nodes.
+// Usage: `DijkstraBatch(graph, pool).Run(sources, targets)`. The object can be reused for other
+// batches.
+template<typename GraphType>
+class DijkstraBatch {
+    const GraphType &graph_;
+    ThreadPool &pool_;
+
+    struct Scratch {
+        vector<int> dist;
+        // `dist_stamp[k] == query` iff `dist[k]` is set in this query, `settled_stamp[k] == query`
+        // iff `k` is settled, `target_stamp[k] == query` iff `k` is a target not settled yet.
+        vector<uint32_t> dist_stamp, settled_stamp, target_stamp;
+        uint32_t query = 0;
+        vector<Rela> heap;
+    };
+    vector<Scratch> scratch_; // One per thread.
+
+    // Next query stamp of `s`. Stamps wrap around after 2^32 - 1 queries, so clear them then.
+    static uint32_t NextQuery(Scratch &s) {
+        if(++s.query == 0) {
+            fill(s.dist_stamp.begin(), s.dist_stamp.end(), 0);
+            fill(s.settled_stamp.begin(), s.settled_stamp.end(), 0);
+            fill(s.target_stamp.begin(), s.target_stamp.end(), 0);
+            s.query = 1;
+        }
+        return s.query;
+    }
+
+    // Dijkstra from `start` until all of `targets` (or all nodes if empty) are settled, and write
+    // the distances to `row`.
+    void Query(Scratch &s, int start, const vector<int> &targets, int *row) {
+        uint32_t q = NextQuery(s);
+        size_t remaining = 0;
+        for(int t: targets)
+            if(s.target_stamp[t] != q) {
+                s.target_stamp[t] = q;
+                remaining++;
+            }
+
+        s.heap.clear();
+        s.heap.push_back({start, 0});
+        s.dist[start] = 0;
+        s.dist_stamp[start] = q;
+        while(!s.heap.empty()) {
+            pop_heap(s.heap.begin(), s.heap.end());
+            auto [k, d] = s.heap.back();
+            s.heap.pop_back();
+            if(s.settled_stamp[k] == q)
+                continue;
+            s.settled_stamp[k] = q;
+            if(s.target_stamp[k] == q) {
+                s.target_stamp[k] = 0;
+                if(--remaining == 0)
+                    break;
+            }
+            for(const auto &e: graph_.edges(k)) {
+                int new_dist = d + e.dist;
+                if(s.dist_stamp[e.node_idx] != q || new_dist < s.dist[e.node_idx]) {
+                    s.dist[e.node_idx] = new_dist;
+                    s.dist_stamp[e.node_idx] = q;
+                    s.heap.push_back({e.node_idx, new_dist});
+                    push_heap(s.heap.begin(), s.heap.end());
+                }
+            }
+        }
+
+        auto dist = [&](int k) {
+            return s.dist_stamp[k] == q ? s.dist[k] : INF;
+        };
+        if(targets.empty())
+            for(int k = 0; k <= graph_.size(); k++)
+                row[k] = dist(k);
+        else
+            for(size_t i = 0; i < targets.size(); i++)
+                row[i] = dist(targets[i]);
+    }
+
+public:
+    DijkstraBatch(const GraphType &graph, ThreadPool &pool)
+        : graph_(graph), pool_(pool), scratch_(pool.size() + 1) {}
+
+    // Row `i` is the distances from `sources[i]`. Column `j` is the distance to `targets[j]`, or
+    // to node `j` if `targets` is empty, like the result of `Dijkstra()`.
+    DistTable Run(const vector<int> &sources, const vector<int> &targets = {}) {
+        int cols = targets.empty() ? graph_.size() + 1 : targets.size();
+        DistTable table(sources.size(), cols);
+        // Each thread takes the next query until none is left, so long queries don't hold up a
+        // whole chunk.
+        atomic<int> next{0};
+        int n_thread = min<int>(scratch_.size(), sources.size());
+        pool_.ParallelFor(n_thread, [&](int t) {
+            Scratch &s = scratch_[t];
+            if(s.dist.empty()) {
+                s.dist.resize(graph_.size() + 1);
+                s.dist_stamp.resize(graph_.size() + 1);
+                s.settled_stamp.resize(graph_.size() + 1);
+                s.target_stamp.resize(graph_.size() + 1);
+            }
+            for(int i; (i = next++) < int(sources.size());)
+                Query(s, sources[i], targets, table[i]);
+        });
+        return table;
+    }
+};
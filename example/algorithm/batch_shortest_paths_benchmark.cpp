@@ -0,0 +1,109 @@
+// `DijkstraBatch` throughput in queries/second (`items_per_second`), against one `Dijkstra()` per
+// source.
+
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Dijkstra.hpp"
+#include "batch_shortest_paths.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 16;
+constexpr int n_source = 256;
+constexpr int n_target = 16;
+
+struct Edge {
+    int a, b, d;
+};
+
+// `n` nodes and `n * 4` random edges, plus a chain to keep it connected.
+const CSRGraph &RandomGraph() {
+    static CSRGraph graph = [] {
+        mt19937 gen(0);
+        uniform_int_distribution<int> node(1, n), dist(0, 1000);
+        vector<Edge> edges;
+        for(int i = 1; i < n; i++)
+            edges.push_back({i, i + 1, dist(gen)});
+        for(int i = 0; i < n * 3; i++)
+            edges.push_back({node(gen), node(gen), dist(gen)});
+        return CSRGraph(n, edges, false);
+    }();
+    return graph;
+}
+
+vector<int> RandomNodes(int count, int seed) {
+    mt19937 gen(seed);
+    vector<int> nodes(count);
+    for(auto &k: nodes)
+        k = gen() % n + 1;
+    return nodes;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Items are queries, i.e. sources.
+
+static void BM_Dijkstra(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph();
+    vector<int> sources = RandomNodes(n_source, 1);
+    for(auto _: state)
+        for(int s: sources)
+            benchmark::DoNotOptimize(Dijkstra(graph, s));
+    state.SetItemsProcessed(state.iterations() * n_source);
+}
+BENCHMARK(BM_Dijkstra)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` is the thread count. All nodes are targets.
+static void BM_DijkstraBatch(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph();
+    vector<int> sources = RandomNodes(n_source, 1);
+    ThreadPool pool(state.range(0) - 1);
+    DijkstraBatch<CSRGraph> batch(graph, pool);
+    for(auto _: state)
+        benchmark::DoNotOptimize(batch.Run(sources));
+    state.SetItemsProcessed(state.iterations() * n_source);
+}
+BENCHMARK(BM_DijkstraBatch)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// `state.range(0)` is the thread count. `n_target` targets, so queries stop early.
+static void BM_DijkstraBatch_Targets(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph();
+    vector<int> sources = RandomNodes(n_source, 1), targets = RandomNodes(n_target, 2);
+    ThreadPool pool(state.range(0) - 1);
+    DijkstraBatch<CSRGraph> batch(graph, pool);
+    for(auto _: state)
+        benchmark::DoNotOptimize(batch.Run(sources, targets));
+    state.SetItemsProcessed(state.iterations() * n_source);
+}
+BENCHMARK(BM_DijkstraBatch_Targets)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+-----------------------------------------------------------------------------------------------
+Benchmark                                     Time             CPU   Iterations UserCounters...
+-----------------------------------------------------------------------------------------------
+BM_Dijkstra                                8274 ms         8172 ms            1 items_per_second=31.3264/s
+BM_DijkstraBatch/1/real_time               8037 ms         7925 ms            1 items_per_second=31.8515/s
+BM_DijkstraBatch_Targets/1/real_time       7244 ms         7099 ms            1 items_per_second=35.3388/s
+
+*/
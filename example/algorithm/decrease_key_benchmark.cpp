@@ -0,0 +1,160 @@
+// Lazy deletion (`Dijkstra()`, `Prim()`) vs. decrease-key (`DijkstraDecreaseKey()`,
+// `PrimDecreaseKey()`) on dense graphs.
+// Besides time, `peak_bytes` reports the peak heap memory allocated by one call.
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <map>
+#include <new>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Dijkstra.hpp"
+#include "Prim.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Allocation tracking. Every allocation stores its size in front of the returned memory.
+// Not inlined, otherwise GCC warns about reading before the allocated object in `delete`.
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+size_t allocated_bytes = 0;
+size_t peak_bytes = 0;
+
+NOINLINE void *operator new(size_t size) {
+    void *p = malloc(size + sizeof(max_align_t));
+    if(!p)
+        throw bad_alloc();
+    *static_cast<size_t *>(p) = size;
+    allocated_bytes += size;
+    peak_bytes = max(peak_bytes, allocated_bytes);
+    return static_cast<char *>(p) + sizeof(max_align_t);
+}
+
+NOINLINE void operator delete(void *ptr) noexcept {
+    if(!ptr)
+        return;
+    void *p = static_cast<char *>(ptr) - sizeof(max_align_t);
+    allocated_bytes -= *static_cast<size_t *>(p);
+    free(p);
+}
+
+NOINLINE void operator delete(void *ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+// Peak memory allocated while running `f()` once.
+template<typename F>
+size_t PeakBytes(F f) {
+    size_t base = allocated_bytes;
+    peak_bytes = base;
+    f();
+    return peak_bytes - base;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+struct Edge {
+    int a, b, d;
+};
+
+// `n` nodes with an edge between each pair with probability 1/2.
+const CSRGraph &DenseGraph(int n) {
+    static map<int, CSRGraph> cache;
+    auto it = cache.find(n);
+    if(it == cache.end()) {
+        mt19937 gen(n);
+        uniform_int_distribution<int> dist(1, 1000);
+        vector<Edge> edges;
+        for(int a = 1; a <= n; a++)
+            for(int b = a + 1; b <= n; b++)
+                if(gen() & 1)
+                    edges.push_back({a, b, dist(gen)});
+        it = cache.emplace(n, CSRGraph(n, edges, false)).first;
+    }
+    return it->second;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the node count.
+
+static void BM_Dijkstra(benchmark::State &state) {
+    const CSRGraph &graph = DenseGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(Dijkstra(graph, 1));
+    state.counters["peak_bytes"] = PeakBytes([&] {
+        Dijkstra(graph, 1);
+    });
+}
+BENCHMARK(BM_Dijkstra)->RangeMultiplier(2)->Range(512, 4096);
+
+static void BM_DijkstraDecreaseKey(benchmark::State &state) {
+    const CSRGraph &graph = DenseGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(DijkstraDecreaseKey(graph, 1));
+    state.counters["peak_bytes"] = PeakBytes([&] {
+        DijkstraDecreaseKey(graph, 1);
+    });
+}
+BENCHMARK(BM_DijkstraDecreaseKey)->RangeMultiplier(2)->Range(512, 4096);
+
+static void BM_Prim(benchmark::State &state) {
+    const CSRGraph &graph = DenseGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(Prim(graph));
+    state.counters["peak_bytes"] = PeakBytes([&] {
+        Prim(graph);
+    });
+}
+BENCHMARK(BM_Prim)->RangeMultiplier(2)->Range(512, 4096);
+
+static void BM_PrimDecreaseKey(benchmark::State &state) {
+    const CSRGraph &graph = DenseGraph(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(PrimDecreaseKey(graph));
+    state.counters["peak_bytes"] = PeakBytes([&] {
+        PrimDecreaseKey(graph);
+    });
+}
+BENCHMARK(BM_PrimDecreaseKey)->RangeMultiplier(2)->Range(512, 4096);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* `-O2 -march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------
+Benchmark                            Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------
+BM_Dijkstra/512                1132533 ns      1091579 ns          240 peak_bytes=51.276k
+BM_Dijkstra/1024               4264962 ns      4257046 ns           69 peak_bytes=102.54k
+BM_Dijkstra/2048              14844715 ns     14392414 ns           16 peak_bytes=205.068k
+BM_Dijkstra/4096              55010348 ns     54802363 ns            5 peak_bytes=410.124k
+BM_DijkstraDecreaseKey/512      347086 ns       333035 ns          758 peak_bytes=12.312k
+BM_DijkstraDecreaseKey/1024    1095696 ns      1088532 ns          269 peak_bytes=24.6k
+BM_DijkstraDecreaseKey/2048    4830285 ns      4812028 ns           55 peak_bytes=49.176k
+BM_DijkstraDecreaseKey/4096   21811887 ns     21394736 ns           13 peak_bytes=98.328k
+BM_Prim/512                   68344208 ns     64372347 ns            4 peak_bytes=1.57294M
+BM_Prim/1024                 604866796 ns    585292917 ns            1 peak_bytes=6.29159M
+BM_Prim/2048                3765240659 ns   3710073011 ns            1 peak_bytes=25.1661M
+BM_Prim/4096                2.7898e+10 ns   2.7522e+10 ns            1 peak_bytes=100.664M
+BM_PrimDecreaseKey/512          892436 ns       890339 ns          260 peak_bytes=12.384k
+BM_PrimDecreaseKey/1024        3607853 ns      3522315 ns           70 peak_bytes=24.736k
+BM_PrimDecreaseKey/2048       16057873 ns     15906865 ns           21 peak_bytes=49.44k
+BM_PrimDecreaseKey/4096       63632031 ns     63148066 ns            4 peak_bytes=98.848k
+
+*/
@@ -0,0 +1,62 @@
+// Delta-stepping
+// Parallel single-source shortest paths.
+
+#include <cassert>
+
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "Dijkstra.hpp"
+#include "delta_stepping.hpp"
+
+int main() {
+    int n = 5;
+    int start = 1;
+    struct Edge {
+        int a, b, d;
+    };
+    vector<Edge> edges{
+        {1, 2, 4},
+        {1, 4, 2},
+        {2, 3, 4},
+        {2, 4, 1},
+        {3, 4, 1},
+        {4, 5, 7},
+        {5, 3, 3},
+    };
+
+    ThreadPool pool(3);
+
+    {
+        Graph graph(n, false);
+        for(const auto &e: edges)
+            graph.AddEdge(e.a, e.b, e.d);
+
+        vector<int> dist = DeltaStepping(graph, 2, pool).Run(start);
+        for(auto d: dist)
+            cout << d << "\n";
+        assert(dist == Dijkstra(graph, start));
+    }
+
+    // Random graphs, directed or not, connected or not, with various `delta`s and thread counts.
+    mt19937 gen(0);
+    for(int t = 0; t < 200; t++) {
+        int n = gen() % 2000 + 1;
+        int m = gen() % (n * 8);
+        int max_dist = gen() % 1000 + 1;
+        Graph graph(n, t % 2);
+        for(int i = 0; i < m; i++)
+            graph.AddEdge(gen() % n + 1, gen() % n + 1, gen() % (max_dist + 1));
+        int delta = gen() % (max_dist * 2) + 1;
+        ThreadPool pool(t % 4);
+        DeltaStepping<Graph> delta_stepping(graph, delta, pool);
+        for(int i = 0; i < 3; i++) {
+            int start = gen() % n + 1;
+            assert(delta_stepping.Run(start) == Dijkstra(graph, start));
+        }
+    }
+
+    return 0;
+}
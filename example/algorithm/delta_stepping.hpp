@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+using namespace std;
+
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// Delta-stepping: parallel single-source shortest paths, for non-negative weights.
+// Nodes are kept in buckets of width `delta` by tentative distance. Buckets are processed in order
+// like Dijkstra's heap, but all nodes of one bucket are relaxed in parallel.
+//     Light edges (`dist <= delta`) may insert into the current bucket, so they are relaxed in
+//     rounds until the bucket stays empty.
+//     Heavy edges (`dist > delta`) never do, so they are relaxed once, after the bucket is done.
+// Small `delta` is close to Dijkstra (little parallelism, no wasted work), large `delta` is close
+// to Bellman-Ford (much parallelism, much wasted work). `delta` >= 1. The max weight divided by the
+// average degree is a good start.
+// Same result as `Dijkstra()`, with `INF` for unreachable nodes.
+// Usage: `DeltaStepping(graph, delta, pool).Run(start)`. The object can be reused for other starts.
+template<typename GraphType>
+class DeltaStepping {
+    const GraphType &graph_;
+    int delta_;
+    ThreadPool &pool_;
+
+    vector<atomic<int>> dist_;
+    vector<atomic<int>> settled_bucket_; // Last bucket which the node was settled in.
+    vector<vector<int>> buckets_;
+
+    // Each chunk of a parallel loop writes to its own buffers, merged after the loop.
+    struct Chunk {
+        vector<int> current; // Nodes improved into the current bucket.
+        vector<pair<int, int>> later; // Nodes improved into later buckets, `{bucket, node}`.
+        vector<int> settled; // Nodes settled in the current bucket.
+    };
+    vector<Chunk> chunks_;
+
+    static bool AtomicMin(atomic<int> &a, int value) {
+        int current = a.load(memory_order_relaxed);
+        while(value < current)
+            if(a.compare_exchange_weak(current, value, memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    void Relax(int b, int k, bool light, Chunk &chunk) {
+        int d = dist_[k].load(memory_order_relaxed);
+        for(const auto &e: graph_.edges(k)) {
+            if((e.dist <= delta_) != light)
+                continue;
+            int new_dist = d + e.dist;
+            if(AtomicMin(dist_[e.node_idx], new_dist)) {
+                int new_b = new_dist / delta_;
+                if(new_b == b)
+                    chunk.current.push_back(e.node_idx);
+                else
+                    chunk.later.push_back({new_b, e.node_idx});
+            }
+        }
+    }
+
+    // Run `f(k, chunk)` for each node `k` in `nodes`, split into chunks.
+    template<typename F>
+    void ForEachChunk(const vector<int> &nodes, F f) {
+        int n_chunk = min<int>(chunks_.size(), (nodes.size() + 255) / 256);
+        pool_.ParallelFor(n_chunk, [&](int c) {
+            size_t begin = nodes.size() * c / n_chunk, end = nodes.size() * (c + 1) / n_chunk;
+            for(size_t i = begin; i < end; i++)
+                f(nodes[i], chunks_[c]);
+        });
+    }
+
+    void MergeLater() {
+        for(auto &chunk: chunks_) {
+            for(auto [b, k]: chunk.later) {
+                if(b >= int(buckets_.size()))
+                    buckets_.resize(b + 1);
+                buckets_[b].push_back(k);
+            }
+            chunk.later.clear();
+        }
+    }
+
+public:
+    DeltaStepping(const GraphType &graph, int delta, ThreadPool &pool)
+        : graph_(graph)
+        , delta_(delta)
+        , pool_(pool)
+        , dist_(graph.size() + 1)
+        , settled_bucket_(graph.size() + 1)
+        , chunks_((pool.size() + 1) * 4) {}
+
+    vector<int> Run(int start) {
+        for(int i = 0; i <= graph_.size(); i++) {
+            dist_[i].store(INF, memory_order_relaxed);
+            settled_bucket_[i].store(-1, memory_order_relaxed);
+        }
+        dist_[start] = 0;
+        buckets_.assign(1, {start});
+
+        vector<int> frontier, settled;
+        for(int b = 0; b < int(buckets_.size()); b++) {
+            settled.clear();
+            frontier.swap(buckets_[b]);
+            while(!frontier.empty()) {
+                ForEachChunk(frontier, [&](int k, Chunk &chunk) {
+                    // Stale. Improved into an earlier bucket after being inserted into this one.
+                    if(dist_[k].load(memory_order_relaxed) / delta_ != b)
+                        return;
+                    if(settled_bucket_[k].exchange(b, memory_order_relaxed) != b)
+                        chunk.settled.push_back(k);
+                    Relax(b, k, true, chunk);
+                });
+                frontier.clear();
+                for(auto &chunk: chunks_) {
+                    frontier.insert(frontier.end(), chunk.current.begin(), chunk.current.end());
+                    chunk.current.clear();
+                    settled.insert(settled.end(), chunk.settled.begin(), chunk.settled.end());
+                    chunk.settled.clear();
+                }
+                MergeLater();
+            }
+
+            ForEachChunk(settled, [&](int k, Chunk &chunk) {
+                Relax(b, k, false, chunk);
+            });
+            MergeLater();
+            buckets_[b] = vector<int>();
+        }
+
+        vector<int> dist(graph_.size() + 1);
+        for(int i = 0; i <= graph_.size(); i++)
+            dist[i] = dist_[i].load(memory_order_relaxed);
+        return dist;
+    }
+};
@@ -0,0 +1,83 @@
+// `DeltaStepping` scaling across 1..N threads, against `Dijkstra()`.
+
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Dijkstra.hpp"
+#include "delta_stepping.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 20;
+constexpr int max_dist = 1000;
+
+struct Edge {
+    int a, b, d;
+};
+
+// `n` nodes and `n * 8` random edges, plus a chain to keep it connected.
+const CSRGraph &RandomGraph() {
+    static CSRGraph graph = [] {
+        mt19937 gen(0);
+        uniform_int_distribution<int> node(1, n), dist(0, max_dist);
+        vector<Edge> edges;
+        for(int i = 1; i < n; i++)
+            edges.push_back({i, i + 1, dist(gen)});
+        for(int i = 0; i < n * 7; i++)
+            edges.push_back({node(gen), node(gen), dist(gen)});
+        return CSRGraph(n, edges, false);
+    }();
+    return graph;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+static void BM_Dijkstra(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph();
+    for(auto _: state)
+        benchmark::DoNotOptimize(Dijkstra(graph, 1));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Dijkstra)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` is the thread count, `state.range(1)` is `delta`.
+static void BM_DeltaStepping(benchmark::State &state) {
+    const CSRGraph &graph = RandomGraph();
+    ThreadPool pool(state.range(0) - 1);
+    DeltaStepping<CSRGraph> delta_stepping(graph, state.range(1), pool);
+    for(auto _: state)
+        benchmark::DoNotOptimize(delta_stepping.Run(1));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DeltaStepping)
+    ->ArgsProduct({
+        benchmark::CreateRange(1, thread::hardware_concurrency(), 2),
+        {max_dist / 16, max_dist / 4, max_dist},
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------------
+Benchmark                                  Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------------
+BM_Dijkstra                             1250 ms         1218 ms            1 items_per_second=861.058k/s
+BM_DeltaStepping/1/62/real_time          866 ms          860 ms            1 items_per_second=1.21138M/s
+BM_DeltaStepping/1/250/real_time         986 ms          978 ms            1 items_per_second=1063.52k/s
+BM_DeltaStepping/1/1000/real_time       1294 ms         1282 ms            1 items_per_second=810.302k/s
+
+*/
@@ -3,25 +3,22 @@
 #include <ctime>
 
 #include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
 #include <vector>
 using namespace std;
 
-void MergeSort(vector<int> &a, int l, int r) {
-    if(l + 1 >= r)
-        return;
-    int m = l + (r - l) / 2;
-    MergeSort(a, l, m);
-    MergeSort(a, m, r);
-    vector<int> temp(r - l);
-    int i = l, j = m, k = 0;
-    while(i != m || j != r) {
-        while(i != m && (j == r || a[i] < a[j]))
-            temp[k++] = a[i++];
-        while(j != r && (i == m || a[i] >= a[j]))
-            temp[k++] = a[j++];
+#include "merge_sort.hpp"
+
+// Trivially copyable, for `ExternalMergeSort()`.
+struct Item {
+    int key, index;
+    bool operator==(const Item &other) const {
+        return key == other.key && index == other.index;
     }
-    copy(temp.begin(), temp.end(), a.begin() + l);
-}
+};
 
 bool CheckSort(vector<int> &a, int l, int r) {
     for(int i = l + 1; i < r; i++)
@@ -46,5 +43,103 @@ int main() {
         assert(a == b);
     }
 
+    // Stability: items with equal keys keep their order.
+    mt19937 gen(0);
+    auto by_key = [](const Item &x, const Item &y) {
+        return x.key < y.key;
+    };
+    auto pairs = [&](int size, int keys) {
+        vector<Item> a(size);
+        for(int i = 0; i < size; i++)
+            a[i] = {int(gen() % keys), i};
+        return a;
+    };
+    vector<Item> buffer;
+    for(int size: {0, 1, 31, 32, 33, 1000, 1 << 16})
+        for(int keys: {1, 10, 1 << 30}) {
+            vector<Item> a = pairs(size, keys), b = a;
+            stable_sort(b.begin(), b.end(), by_key);
+            BottomUpMergeSort(a.begin(), a.end(), buffer, by_key);
+            assert(a == b);
+        }
+
+    // Parallel, with thread counts that give odd and even numbers of chunks.
+    for(int threads: {1, 2, 3, 4, 7}) {
+        ThreadPool pool(threads - 1);
+        for(int size: {1000, 1 << 14, 100003}) {
+            vector<Item> a = pairs(size, 100), b = a;
+            stable_sort(b.begin(), b.end(), by_key);
+            ParallelMergeSort(a.begin(), a.end(), buffer, pool, by_key);
+            assert(a == b);
+        }
+    }
+    {
+        vector<string> a(1 << 15), b;
+        for(auto &x: a)
+            x = to_string(gen());
+        b = a;
+        sort(b.begin(), b.end());
+        vector<string> buffer;
+        ThreadPool pool(3);
+        ParallelMergeSort(a.begin(), a.end(), buffer, pool);
+        assert(a == b);
+    }
+
+    // `LoserTree` merging sorted lists, some of them empty.
+    {
+        vector<vector<int>> lists(5);
+        vector<int> all;
+        for(int i = 0; i < 5; i++)
+            for(int j = gen() % 50 * (i % 2); j > 0; j--) {
+                lists[i].push_back(gen() % 100);
+                all.push_back(lists[i].back());
+            }
+        for(auto &list: lists)
+            sort(list.begin(), list.end());
+        sort(all.begin(), all.end());
+        LoserTree<int> tree(lists.size());
+        vector<size_t> next(lists.size());
+        for(size_t i = 0; i < lists.size(); i++)
+            if(!lists[i].empty())
+                tree.Set(i, lists[i][next[i]++]);
+        tree.Build();
+        vector<int> merged;
+        while(!tree.empty()) {
+            merged.push_back(tree.TopKey());
+            int i = tree.Top();
+            if(next[i] < lists[i].size())
+                tree.ReplaceTop(lists[i][next[i]++]);
+            else
+                tree.PopTop();
+        }
+        assert(merged == all);
+    }
+
+    // External, with memory for 1, a few and many runs, and stable.
+    {
+        const string input = "merge_sort_input.bin", output = "merge_sort_output.bin";
+        for(int size: {0, 1, 1000, 100000})
+            for(size_t memory: {size_t(1) << 24, size_t(1) << 16, size_t(1) << 10}) {
+                vector<Item> a = pairs(size, 1000), b = a;
+                stable_sort(b.begin(), b.end(), by_key);
+                FILE *file = fopen(input.c_str(), "wb");
+                if(size)
+                    fwrite(a.data(), sizeof(a[0]), a.size(), file);
+                fclose(file);
+                assert(ExternalMergeSort<Item>(input, output, memory, by_key));
+                vector<Item> c(size + 1);
+                file = fopen(output.c_str(), "rb");
+                assert(fread(c.data(), sizeof(c[0]), c.size(), file) == size_t(size));
+                fclose(file);
+                c.pop_back();
+                assert(c == b);
+                // No runs are left behind.
+                assert(!fopen((output + ".run0").c_str(), "rb"));
+            }
+        assert(!ExternalMergeSort<int>("no/such/file", output, 1 << 20));
+        remove(input.c_str());
+        remove(output.c_str());
+    }
+
     return 0;
 }
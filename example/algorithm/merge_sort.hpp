@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#include "ThreadPool.hpp"
+
+void MergeSort(vector<int> &a, int l, int r) {
+    if(l + 1 >= r)
+        return;
+    int m = l + (r - l) / 2;
+    MergeSort(a, l, m);
+    MergeSort(a, m, r);
+    vector<int> temp(r - l);
+    int i = l, j = m, k = 0;
+    while(i != m || j != r) {
+        while(i != m && (j == r || a[i] < a[j]))
+            temp[k++] = a[i++];
+        while(j != r && (i == m || a[i] >= a[j]))
+            temp[k++] = a[j++];
+    }
+    copy(temp.begin(), temp.end(), a.begin() + l);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Bottom-up merge sort with one buffer.
+
+// Runs of this size are insertion sorted before the first merge pass.
+constexpr ptrdiff_t merge_sort_run = 32;
+
+// Insertion sort each run of `merge_sort_run` elements of [first, last).
+template<typename It, typename Compare>
+void SortRuns(It first, It last, Compare comp) {
+    for(It run = first; run != last;) {
+        It run_last = last - run > merge_sort_run ? run + merge_sort_run : last;
+        for(It i = run + 1; i < run_last; ++i) {
+            auto x = move(*i);
+            It j = i;
+            for(; j != run && comp(x, *(j - 1)); --j)
+                *j = move(*(j - 1));
+            *j = move(x);
+        }
+        run = run_last;
+    }
+}
+
+// Stable merge of sorted [first1, last1) and [first2, last2) into `out`, moving the elements.
+// For arithmetic types the element taken is selected rather than branched on, since on random
+// input the branch is mispredicted half of the time.
+template<typename In, typename Out, typename Compare>
+Out MergeMove(In first1, In last1, In first2, In last2, Out out, Compare comp) {
+    if constexpr(is_arithmetic<typename iterator_traits<In>::value_type>::value) {
+        while(first1 != last1 && first2 != last2) {
+            bool second = comp(*first2, *first1);
+            *out++ = second ? *first2 : *first1;
+            first1 += !second;
+            first2 += second;
+        }
+        out = copy(first1, last1, out);
+        return copy(first2, last2, out);
+    } else {
+        return merge(make_move_iterator(first1), make_move_iterator(last1),
+                     make_move_iterator(first2), make_move_iterator(last2), out, comp);
+    }
+}
+
+// Merge each pair of sorted runs of `width` elements of `n` from `from` into `to`.
+template<typename From, typename To, typename Compare>
+void MergePass(From from, To to, ptrdiff_t n, ptrdiff_t width, Compare comp) {
+    for(ptrdiff_t low = 0; low < n; low += width * 2) {
+        ptrdiff_t mid = min(low + width, n), high = min(low + width * 2, n);
+        MergeMove(from + low, from + mid, from + mid, from + high, to + low, comp);
+    }
+}
+
+// Sort [first, last) with [buffer, buffer + (last - first)) as scratch. Passes merge back and forth
+// between the two, so each pass moves every element once, and there is one final copy only if the
+// number of passes is odd.
+template<typename It, typename Buffer, typename Compare>
+void MergeSortWithBuffer(It first, It last, Buffer buffer, Compare comp) {
+    ptrdiff_t n = last - first;
+    SortRuns(first, last, comp);
+    bool in_buffer = false;
+    for(ptrdiff_t width = merge_sort_run; width < n; width *= 2) {
+        if(in_buffer)
+            MergePass(buffer, first, n, width, comp);
+        else
+            MergePass(first, buffer, n, width, comp);
+        in_buffer = !in_buffer;
+    }
+    if(in_buffer)
+        move(buffer, buffer + n, first);
+}
+
+// Stable sort of [first, last). `buffer` is resized to the input if it's smaller, and can be
+// reused by later sorts, so they allocate nothing.
+template<typename It, typename Compare = less<>>
+void BottomUpMergeSort(It first, It last, vector<typename iterator_traits<It>::value_type> &buffer,
+                       Compare comp = Compare()) {
+    if(buffer.size() < size_t(last - first))
+        buffer.resize(last - first);
+    MergeSortWithBuffer(first, last, buffer.begin(), comp);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Parallel merge sort.
+
+// The number of elements of [a, a + n_a) among the first `d` elements of its stable merge with
+// [b, b + n_b). The first `d` outputs are then [a, a + i) and [b, b + d - i), so the output can be
+// split anywhere without merging, and the parts merged independently (merge path, Odeh et al.
+// 2012).
+template<typename It, typename Compare>
+ptrdiff_t MergePathSplit(It a, ptrdiff_t n_a, It b, ptrdiff_t n_b, ptrdiff_t d, Compare comp) {
+    ptrdiff_t low = max(ptrdiff_t(0), d - n_b), high = min(d, n_a);
+    while(low < high) {
+        ptrdiff_t mid = low + (high - low) / 2;
+        if(comp(b[d - mid - 1], a[mid]))
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return low;
+}
+
+// Stable sort of [first, last) on `pool`, with `buffer` like `BottomUpMergeSort()`.
+// One chunk per thread is sorted by `BottomUpMergeSort()`, then chunks are merged pairwise in
+// rounds. In each round, every merge is split by `MergePathSplit()` into parts of equal size, one
+// thread each, so the last rounds, which have fewer merges than threads, keep all threads busy.
+template<typename It, typename Compare = less<>>
+void ParallelMergeSort(It first, It last, vector<typename iterator_traits<It>::value_type> &buffer,
+                       ThreadPool &pool, Compare comp = Compare()) {
+    int n_chunk = pool.size() + 1;
+    ptrdiff_t n = last - first;
+    if(n_chunk == 1 || n < ptrdiff_t(1) << 14) {
+        BottomUpMergeSort(first, last, buffer, comp);
+        return;
+    }
+    if(buffer.size() < size_t(n))
+        buffer.resize(n);
+    vector<ptrdiff_t> bounds(n_chunk + 1);
+    for(int i = 0; i <= n_chunk; i++)
+        bounds[i] = n * i / n_chunk;
+    pool.ParallelFor(n_chunk, [&](int i) {
+        MergeSortWithBuffer(first + bounds[i], first + bounds[i + 1], buffer.begin() + bounds[i],
+                            comp);
+    });
+
+    // A round first finds all the splits, then merges the parts, which move from the elements that
+    // the splits of other parts compare.
+    vector<ptrdiff_t> splits;
+    auto round = [&](auto from, auto to, int width) {
+        int n_merge = (n_chunk + width * 2 - 1) / (width * 2);
+        int n_part = max(n_chunk / n_merge, 1);
+        // Merge `m` is of [low, low + n_a) and [low + n_a, low + n_a + n_b).
+        struct Merge {
+            ptrdiff_t low, n_a, n_b;
+        };
+        auto get_merge = [&](int m) {
+            int low = m * width * 2, mid = min(low + width, n_chunk);
+            int high = min(low + width * 2, n_chunk);
+            return Merge{bounds[low], bounds[mid] - bounds[low], bounds[high] - bounds[mid]};
+        };
+        splits.resize(n_merge * (n_part + 1));
+        pool.ParallelFor(splits.size(), [&](int t) {
+            Merge job = get_merge(t / (n_part + 1));
+            ptrdiff_t d = (job.n_a + job.n_b) * (t % (n_part + 1)) / n_part;
+            splits[t] = MergePathSplit(from + job.low, job.n_a, from + job.low + job.n_a, job.n_b,
+                                       d, comp);
+        });
+        pool.ParallelFor(n_merge * n_part, [&](int t) {
+            int m = t / n_part, part = t % n_part;
+            Merge job = get_merge(m);
+            ptrdiff_t d0 = (job.n_a + job.n_b) * part / n_part;
+            ptrdiff_t d1 = (job.n_a + job.n_b) * (part + 1) / n_part;
+            ptrdiff_t i0 = splits[m * (n_part + 1) + part];
+            ptrdiff_t i1 = splits[m * (n_part + 1) + part + 1];
+            auto a = from + job.low, b = a + job.n_a;
+            MergeMove(a + i0, a + i1, b + (d0 - i0), b + (d1 - i1), to + job.low + d0, comp);
+        });
+    };
+    bool in_buffer = false;
+    for(int width = 1; width < n_chunk; width *= 2) {
+        if(in_buffer)
+            round(buffer.begin(), first, width);
+        else
+            round(first, buffer.begin(), width);
+        in_buffer = !in_buffer;
+    }
+    if(in_buffer)
+        pool.ParallelFor(n_chunk, [&](int i) {
+            move(buffer.begin() + bounds[i], buffer.begin() + bounds[i + 1], first + bounds[i]);
+        });
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// External merge sort.
+
+// A tournament tree for merging k sorted sources, each represented by its current key.
+// Each internal node keeps the loser of the match played there and the winner goes on up, so after
+// the winner's source moves to its next key only the matches on its path to the root are replayed,
+// against the losers stored there: log2(k) comparisons per element, against about 2 log2(k) for
+// sifting down a binary heap.
+// Ties go to the source with the lower index, so merging runs in input order is stable.
+// Usage: `Set()` each source that has a key, `Build()`, then take `Top()` until `empty()`, moving
+// its source on with `ReplaceTop()` or `PopTop()`.
+template<typename T, typename Compare = less<>>
+class LoserTree {
+    vector<T> keys_;
+    vector<char> done_; // Sources without keys left.
+    vector<int> tree_; // `tree_[0]` is the winner, `tree_[1..k)` the losers of the internal nodes.
+    Compare comp_;
+
+    bool Before(int a, int b) const {
+        if(done_[a] || done_[b])
+            return done_[a] < done_[b] || (done_[a] == done_[b] && a < b);
+        if(comp_(keys_[a], keys_[b]))
+            return true;
+        return !comp_(keys_[b], keys_[a]) && a < b;
+    }
+    // Leaves are `tree_` indexes k..2k-1.
+    void Replay(int i) {
+        for(int node = (i + int(keys_.size())) / 2; node > 0; node /= 2)
+            if(Before(tree_[node], i))
+                swap(tree_[node], i);
+        tree_[0] = i;
+    }
+
+public:
+    // `k` >= 1 sources, all without keys until `Set()`.
+    explicit LoserTree(int k, const Compare &comp = Compare())
+        : keys_(k), done_(k, 1), tree_(k), comp_(comp) {}
+
+    void Set(int i, T key) {
+        keys_[i] = move(key);
+        done_[i] = 0;
+    }
+
+    void Build() {
+        int k = keys_.size();
+        vector<int> winner(k * 2);
+        for(int i = 0; i < k; i++)
+            winner[k + i] = i;
+        for(int node = k - 1; node > 0; node--) {
+            int a = winner[node * 2], b = winner[node * 2 + 1];
+            bool a_wins = Before(a, b);
+            winner[node] = a_wins ? a : b;
+            tree_[node] = a_wins ? b : a;
+        }
+        tree_[0] = winner[1];
+    }
+
+    // The source with the least key.
+    int Top() const {
+        return tree_[0];
+    }
+
+    const T &TopKey() const {
+        return keys_[tree_[0]];
+    }
+
+    // The next key of the top source.
+    void ReplaceTop(T key) {
+        keys_[tree_[0]] = move(key);
+        Replay(tree_[0]);
+    }
+
+    // The top source has no keys left.
+    void PopTop() {
+        done_[tree_[0]] = 1;
+        Replay(tree_[0]);
+    }
+
+    bool empty() const {
+        return done_[tree_[0]];
+    }
+};
+
+// Sort the file `input` of trivially copyable `T`s into `output`, which may be larger than
+// memory, using buffers of about `memory` bytes in total. Chunks that fit are sorted by
+// `BottomUpMergeSort()` and written as runs next to `output`, then all runs are merged in one pass
+// by a `LoserTree`, each read through its own buffer. Every element is read and written twice.
+// The memory is split among more buffers as the runs get more, so reads get smaller and seeks
+// dominate: reads of R bytes from a file of N bytes need about sqrt(2 N R) bytes of memory, e.g.
+// 362 MiB for 1 MiB reads from 64 GiB.
+// Stable. Returns false if a file can't be read or written.
+template<typename T, typename Compare = less<>>
+bool ExternalMergeSort(const string &input, const string &output, size_t memory,
+                       Compare comp = Compare()) {
+    static_assert(is_trivially_copyable<T>::value);
+    vector<string> runs;
+    auto remove_runs = [&] {
+        for(const string &run: runs)
+            remove(run.c_str());
+    };
+
+    // Sorted runs of half the memory, the other half being the buffer of the sort.
+    FILE *in = fopen(input.c_str(), "rb");
+    if(!in)
+        return false;
+    vector<T> chunk(max(memory / sizeof(T) / 2, size_t(1))), buffer;
+    bool ok = true;
+    while(ok) {
+        size_t size = fread(chunk.data(), sizeof(T), chunk.size(), in);
+        if(size == 0)
+            break;
+        BottomUpMergeSort(chunk.begin(), chunk.begin() + size, buffer, comp);
+        runs.push_back(output + ".run" + to_string(runs.size()));
+        FILE *out = fopen(runs.back().c_str(), "wb");
+        ok = out && fwrite(chunk.data(), sizeof(T), size, out) == size;
+        ok = out && fclose(out) == 0 && ok;
+    }
+    ok = !ferror(in) && ok;
+    fclose(in);
+    chunk = vector<T>();
+    buffer = vector<T>();
+    if(!ok) {
+        remove_runs();
+        return false;
+    }
+
+    // Merge with one buffer per run and one for the output.
+    int k = runs.size();
+    size_t size = max(memory / sizeof(T) / (k + 1), size_t(1));
+    struct Run {
+        FILE *file = nullptr;
+        vector<T> buffer;
+        size_t position = 0, size = 0;
+    };
+    vector<Run> readers(k);
+    // The next key of run `i` into `key`, or false at its end or on an error.
+    auto next = [&](int i, T &key) {
+        Run &run = readers[i];
+        if(run.position == run.size) {
+            run.size = fread(run.buffer.data(), sizeof(T), run.buffer.size(), run.file);
+            run.position = 0;
+            if(run.size == 0) {
+                ok = !ferror(run.file) && ok;
+                return false;
+            }
+        }
+        key = run.buffer[run.position++];
+        return true;
+    };
+    FILE *out = fopen(output.c_str(), "wb");
+    ok = out != nullptr;
+    for(int i = 0; i < k; i++) {
+        readers[i].file = fopen(runs[i].c_str(), "rb");
+        readers[i].buffer.resize(size);
+        ok = readers[i].file && ok;
+    }
+    if(ok && k > 0) {
+        LoserTree<T, Compare> tree(k, comp);
+        T key;
+        for(int i = 0; i < k; i++)
+            if(next(i, key))
+                tree.Set(i, key);
+        tree.Build();
+        vector<T> written;
+        written.reserve(size);
+        while(!tree.empty()) {
+            written.push_back(tree.TopKey());
+            if(written.size() == size) {
+                ok = fwrite(written.data(), sizeof(T), size, out) == size && ok;
+                written.clear();
+            }
+            if(next(tree.Top(), key))
+                tree.ReplaceTop(key);
+            else
+                tree.PopTop();
+        }
+        ok = fwrite(written.data(), sizeof(T), written.size(), out) == written.size() && ok;
+    }
+    for(Run &run: readers)
+        if(run.file)
+            fclose(run.file);
+    ok = out && fclose(out) == 0 && ok;
+    remove_runs();
+    if(!ok)
+        remove(output.c_str());
+    return ok;
+}
@@ -0,0 +1,134 @@
+// Merge sort: `MergeSort()`, `std::stable_sort()`, `BottomUpMergeSort()` and `ParallelMergeSort()`
+// in memory, then `ExternalMergeSort()` on a file with memory for different numbers of runs.
+// `ParallelMergeSort()` is swept across 1..N threads.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "merge_sort.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 22;
+constexpr int n_file = 1 << 25; // 128 MiB of `int`.
+
+const vector<int> &Input() {
+    static vector<int> input;
+    if(input.empty()) {
+        mt19937 gen(0);
+        input.resize(n);
+        for(int &x: input)
+            x = gen();
+    }
+    return input;
+}
+
+// Sort a fresh copy of the input in each iteration. Copying isn't timed.
+template<typename Sort>
+void Run(benchmark::State &state, Sort sort) {
+    vector<int> a;
+    for(auto _: state) {
+        state.PauseTiming();
+        a = Input();
+        state.ResumeTiming();
+        sort(a);
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// In memory. The buffers of the bottom-up sorts are allocated once, outside the timing.
+// Items are elements.
+
+static void BM_MergeSort(benchmark::State &state) {
+    Run(state, [](vector<int> &a) {
+        MergeSort(a, 0, a.size());
+    });
+}
+BENCHMARK(BM_MergeSort)->Unit(benchmark::kMillisecond);
+
+static void BM_StdStableSort(benchmark::State &state) {
+    Run(state, [](vector<int> &a) {
+        stable_sort(a.begin(), a.end());
+    });
+}
+BENCHMARK(BM_StdStableSort)->Unit(benchmark::kMillisecond);
+
+static void BM_BottomUpMergeSort(benchmark::State &state) {
+    vector<int> buffer(n);
+    Run(state, [&](vector<int> &a) {
+        BottomUpMergeSort(a.begin(), a.end(), buffer);
+    });
+}
+BENCHMARK(BM_BottomUpMergeSort)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` is the thread count.
+static void BM_ParallelMergeSort(benchmark::State &state) {
+    ThreadPool pool(state.range(0) - 1);
+    vector<int> buffer(n);
+    Run(state, [&](vector<int> &a) {
+        ParallelMergeSort(a.begin(), a.end(), buffer, pool);
+    });
+}
+BENCHMARK(BM_ParallelMergeSort)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// On disk. `state.range(0)` is the memory in MiB, for 256, 64 and 16 runs of `n_file` elements.
+// The files fit in the page cache here, so this measures the sorting and the system calls rather
+// than the disk. Bytes are of the input.
+
+const string input_path = "merge_sort_benchmark_input.bin";
+const string output_path = "merge_sort_benchmark_output.bin";
+
+void WriteInput() {
+    mt19937 gen(0);
+    vector<int> a(n_file);
+    for(int &x: a)
+        x = gen();
+    FILE *file = fopen(input_path.c_str(), "wb");
+    fwrite(a.data(), sizeof(int), a.size(), file);
+    fclose(file);
+}
+
+static void BM_ExternalMergeSort(benchmark::State &state) {
+    WriteInput();
+    for(auto _: state)
+        ExternalMergeSort<int>(input_path, output_path, size_t(state.range(0)) << 20);
+    state.SetBytesProcessed(state.iterations() * n_file * sizeof(int));
+    remove(input_path.c_str());
+    remove(output_path.c_str());
+}
+BENCHMARK(BM_ExternalMergeSort)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+-------------------------------------------------------------------------------------------
+Benchmark                                 Time             CPU   Iterations UserCounters...
+-------------------------------------------------------------------------------------------
+BM_MergeSort                           1043 ms         1021 ms            1 items_per_second=4.10997M/s
+BM_StdStableSort                        760 ms          694 ms            1 items_per_second=6.04457M/s
+BM_BottomUpMergeSort                    481 ms          472 ms            2 items_per_second=8.87876M/s
+BM_ParallelMergeSort/1/real_time        520 ms          493 ms            2 items_per_second=8.07191M/s
+BM_ExternalMergeSort/1                 7698 ms         7426 ms            1 bytes_per_second=17.2373M/s
+BM_ExternalMergeSort/4                 6456 ms         6202 ms            1 bytes_per_second=20.6388M/s
+BM_ExternalMergeSort/16                5648 ms         5472 ms            1 bytes_per_second=23.3922M/s
+*/
@@ -0,0 +1,143 @@
+// Minimum spanning tree: `Kruskal()`, `FilterKruskal`, `Boruvka`, `Prim()` and `PrimDecreaseKey()`
+// on sparse and dense graphs. `Boruvka` is also swept across 1..N threads for strong scaling.
+
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "Boruvka.hpp"
+#include "Kruskal.hpp"
+#include "Prim.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+struct MSTGraph {
+    int n;
+    vector<Edge> edges;
+    CSRGraph csr;
+};
+
+// `n` nodes and `m` random edges with weights in [0, 1000), plus a chain to keep it connected.
+MSTGraph RandomGraph(int n, size_t m) {
+    mt19937 gen(n);
+    vector<Edge> edges;
+    for(int i = 1; i < n; i++)
+        edges.push_back({i, i + 1, int(gen() % 1000)});
+    while(edges.size() < m)
+        edges.push_back({int(gen() % n + 1), int(gen() % n + 1), int(gen() % 1000)});
+    shuffle(edges.begin(), edges.end(), gen);
+    CSRGraph csr(n, edges, false);
+    return {n, move(edges), move(csr)};
+}
+
+// Average degree 8.
+const MSTGraph &SparseGraph() {
+    static MSTGraph graph = RandomGraph(1 << 18, (1 << 18) * 4);
+    return graph;
+}
+
+// Half of all node pairs.
+const MSTGraph &DenseGraph() {
+    static MSTGraph graph = RandomGraph(1 << 12, (1 << 12) * (1 << 12) / 4);
+    return graph;
+}
+
+const MSTGraph &GetGraph(bool dense) {
+    return dense ? DenseGraph() : SparseGraph();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Items are edges.
+
+static void BM_Kruskal(benchmark::State &state, bool dense) {
+    const MSTGraph &graph = GetGraph(dense);
+    for(auto _: state)
+        benchmark::DoNotOptimize(Kruskal(graph.n, graph.edges));
+    state.SetItemsProcessed(state.iterations() * graph.edges.size());
+}
+BENCHMARK_CAPTURE(BM_Kruskal, Sparse, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Kruskal, Dense, true)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` is the thread count.
+static void BM_FilterKruskal(benchmark::State &state, bool dense) {
+    const MSTGraph &graph = GetGraph(dense);
+    ThreadPool pool(state.range(0) - 1);
+    for(auto _: state)
+        benchmark::DoNotOptimize(FilterKruskal(graph.n, pool).Run(graph.edges));
+    state.SetItemsProcessed(state.iterations() * graph.edges.size());
+}
+BENCHMARK_CAPTURE(BM_FilterKruskal, Sparse, false)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_FilterKruskal, Dense, true)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// `state.range(0)` is the thread count.
+static void BM_Boruvka(benchmark::State &state, bool dense) {
+    const MSTGraph &graph = GetGraph(dense);
+    ThreadPool pool(state.range(0) - 1);
+    vector<Edge> tree;
+    for(auto _: state)
+        benchmark::DoNotOptimize(Boruvka(graph.n, pool).Run(graph.edges, tree));
+    state.SetItemsProcessed(state.iterations() * graph.edges.size());
+}
+BENCHMARK_CAPTURE(BM_Boruvka, Sparse, false)
+    ->DenseRange(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Boruvka, Dense, true)
+    ->DenseRange(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_Prim(benchmark::State &state, bool dense) {
+    const MSTGraph &graph = GetGraph(dense);
+    for(auto _: state)
+        benchmark::DoNotOptimize(Prim(graph.csr));
+    state.SetItemsProcessed(state.iterations() * graph.edges.size());
+}
+BENCHMARK_CAPTURE(BM_Prim, Sparse, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Prim, Dense, true)->Unit(benchmark::kMillisecond);
+
+static void BM_PrimDecreaseKey(benchmark::State &state, bool dense) {
+    const MSTGraph &graph = GetGraph(dense);
+    for(auto _: state)
+        benchmark::DoNotOptimize(PrimDecreaseKey(graph.csr));
+    state.SetItemsProcessed(state.iterations() * graph.edges.size());
+}
+BENCHMARK_CAPTURE(BM_PrimDecreaseKey, Sparse, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PrimDecreaseKey, Dense, true)->Unit(benchmark::kMillisecond);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+----------------------------------------------------------------------------------------------
+Benchmark                                    Time             CPU   Iterations UserCounters...
+----------------------------------------------------------------------------------------------
+BM_Kruskal/Sparse                         83.4 ms         82.3 ms            8 items_per_second=12.7479M/s
+BM_Kruskal/Dense                           292 ms          289 ms            2 items_per_second=14.5288M/s
+BM_FilterKruskal/Sparse/1/real_time       50.1 ms         49.9 ms           13 items_per_second=20.9099M/s
+BM_FilterKruskal/Dense/1/real_time         109 ms          108 ms            6 items_per_second=38.5923M/s
+BM_Boruvka/Sparse/1/real_time              205 ms          202 ms            4 items_per_second=5.12479M/s
+BM_Boruvka/Dense/1/real_time               432 ms          427 ms            2 items_per_second=9.70153M/s
+BM_Prim/Sparse                             521 ms          517 ms            1 items_per_second=2.02894M/s
+BM_Prim/Dense                            25770 ms        25441 ms            1 items_per_second=164.867k/s
+BM_PrimDecreaseKey/Sparse                  187 ms          186 ms            3 items_per_second=5.64788M/s
+BM_PrimDecreaseKey/Dense                  53.4 ms         52.9 ms           14 items_per_second=79.2239M/s
+
+*/
@@ -3,39 +3,13 @@
 #include <ctime>
 
 #include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
 #include <vector>
 using namespace std;
 
-// clang-format off
-void QuickSort0(vector<int> &a, int l, int r) {
-    if(l >= r) return;
-    int i = l, j = r;
-    swap(a[i], a[(i + j) / 2]);
-    int x = a[i];
-    while(i < j) {
-        while(i < j && a[j] > x) j--;
-        if(i < j) a[i++] = a[j];
-        while(i < j && a[i] < x) i++;
-        if(i < j) a[j--] = a[i];
-    }
-    a[i] = x;
-    QuickSort0(a, l, i - 1);
-    QuickSort0(a, i + 1, r);
-}
-
-void QuickSort1(vector<int> &a, int l, int r) {
-    if(l >= r) return;
-    int i = l, j = r;
-    int x = a[(i + j) / 2];
-    while(i <= j) {
-        while(i <= j && a[i] < x) i++;
-        while(i <= j && a[j] > x) j--;
-        if(i <= j) swap(a[i++], a[j--]);
-    }
-    QuickSort1(a, l, i - 1);
-    QuickSort1(a, i, r);
-}
-// clang-format on
+#include "quick_sort.hpp"
 
 int main() {
     int n = 100;
@@ -62,5 +36,78 @@ int main() {
         assert(a == b);
     }
 
+    // Random, sorted, reversed, organ-pipe and few distinct keys, around the thresholds and the
+    // block size of the partition.
+    mt19937 gen(0);
+    auto inputs = [&](int size) {
+        vector<vector<int>> inputs(5, vector<int>(size));
+        for(int i = 0; i < size; i++) {
+            inputs[0][i] = gen();
+            inputs[1][i] = i;
+            inputs[2][i] = size - i;
+            inputs[3][i] = min(i, size - i);
+            inputs[4][i] = gen() % 4;
+        }
+        return inputs;
+    };
+    for(int size: {0, 1, 2, 3, 24, 25, 128, 129, 1000, 1 << 16})
+        for(vector<int> &a: inputs(size)) {
+            vector<int> b = a;
+            sort(b.begin(), b.end());
+            vector<int> c = a;
+            IntroSort(c.begin(), c.end());
+            assert(c == b);
+            c = a;
+            IntroSort(c.begin(), c.end(), greater<>());
+            assert(equal(c.rbegin(), c.rend(), b.begin()));
+            vector<float> f(a.begin(), a.end());
+            IntroSort(f.begin(), f.end());
+            assert(equal(f.begin(), f.end(), b.begin()));
+        }
+
+    // Comparisons with branches, on a type that isn't arithmetic.
+    vector<string> s(1000);
+    for(auto &x: s)
+        x = to_string(gen() % 100);
+    vector<string> t = s;
+    IntroSort(s.begin(), s.end());
+    sort(t.begin(), t.end());
+    assert(s == t);
+
+    // McIlroy's adversary decides the values lazily during the sort, so that every pivot is as bad
+    // as possible, which drives any quicksort to O(n^2). Introsort falls back to heap sort instead,
+    // which is checked by counting comparisons.
+    {
+        int size = 1 << 12, gas = size, solid = 0, candidate = 0;
+        vector<int> value(size, gas), index(size);
+        for(int i = 0; i < size; i++)
+            index[i] = i;
+        long long comparisons = 0;
+        IntroSort(index.begin(), index.end(), [&](int x, int y) {
+            comparisons++;
+            if(value[x] == gas && value[y] == gas)
+                value[x == candidate ? x : y] = solid++;
+            if(value[x] == gas)
+                candidate = x;
+            else if(value[y] == gas)
+                candidate = y;
+            return value[x] < value[y];
+        });
+        for(int i = 1; i < size; i++)
+            assert(value[index[i - 1]] <= value[index[i]]);
+        assert(comparisons < 100LL * size);
+    }
+
+    // Parallel, with 1 and 4 threads.
+    for(int threads: {1, 4}) {
+        ThreadPool pool(threads - 1);
+        for(vector<int> &a: inputs(1 << 18)) {
+            vector<int> b = a;
+            sort(b.begin(), b.end());
+            ParallelIntroSort(a.begin(), a.end(), pool);
+            assert(a == b);
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#include "ThreadPool.hpp"
+
+// clang-format off
+void QuickSort0(vector<int> &a, int l, int r) {
+    if(l >= r) return;
+    int i = l, j = r;
+    swap(a[i], a[(i + j) / 2]);
+    int x = a[i];
+    while(i < j) {
+        while(i < j && a[j] > x) j--;
+        if(i < j) a[i++] = a[j];
+        while(i < j && a[i] < x) i++;
+        if(i < j) a[j--] = a[i];
+    }
+    a[i] = x;
+    QuickSort0(a, l, i - 1);
+    QuickSort0(a, i + 1, r);
+}
+
+void QuickSort1(vector<int> &a, int l, int r) {
+    if(l >= r) return;
+    int i = l, j = r;
+    int x = a[(i + j) / 2];
+    while(i <= j) {
+        while(i <= j && a[i] < x) i++;
+        while(i <= j && a[j] > x) j--;
+        if(i <= j) swap(a[i++], a[j--]);
+    }
+    QuickSort1(a, l, i - 1);
+    QuickSort1(a, i, r);
+}
+// clang-format on
+
+/*------------------------------------------------------------------------------------------------*/
+// Introsort, for production use.
+
+// Ranges up to this size are insertion sorted.
+constexpr ptrdiff_t insertion_sort_threshold = 24;
+// Ranges above this size take Tukey's ninther as the pivot instead of the median of 3.
+constexpr ptrdiff_t ninther_threshold = 128;
+// Elements compared at once by the branchless partition. Offsets in a block must fit a byte.
+constexpr int partition_block_size = 64;
+
+// Whether comparisons are cheap and free of side effects, so that comparing a whole block before
+// moving anything pays off.
+template<typename T, typename Compare>
+constexpr bool branchless_partition =
+    is_arithmetic<T>::value && (is_same<Compare, less<T>>::value || is_same<Compare, less<>>::value
+                                || is_same<Compare, greater<T>>::value
+                                || is_same<Compare, greater<>>::value);
+
+template<typename It, typename Compare>
+void InsertionSort(It first, It last, Compare comp) {
+    if(first == last)
+        return;
+    for(It i = first + 1; i != last; ++i) {
+        auto x = move(*i);
+        It j = i;
+        for(; j != first && comp(x, *(j - 1)); --j)
+            *j = move(*(j - 1));
+        *j = move(x);
+    }
+}
+
+template<typename It, typename Compare>
+void Sort3(It a, It b, It c, Compare comp) {
+    if(comp(*b, *a))
+        iter_swap(a, b);
+    if(comp(*c, *b))
+        iter_swap(b, c);
+    if(comp(*b, *a))
+        iter_swap(a, b);
+}
+
+// Move the median of the first, middle and last elements, or for large ranges Tukey's ninther (the
+// median of 3 such medians), to `*first`. Sorted, reversed and organ-pipe inputs get good pivots.
+template<typename It, typename Compare>
+void ChoosePivot(It first, It last, Compare comp) {
+    ptrdiff_t half = (last - first) / 2;
+    if(last - first > ninther_threshold) {
+        Sort3(first, first + half, last - 1, comp);
+        Sort3(first + 1, first + (half - 1), last - 2, comp);
+        Sort3(first + 2, first + (half + 1), last - 3, comp);
+        Sort3(first + (half - 1), first + half, first + (half + 1), comp);
+        iter_swap(first, first + half);
+    } else {
+        Sort3(first + half, first, last - 1, comp);
+    }
+}
+
+// Move the elements of [first, last) for which `pred` is true before the others, and return the
+// boundary. With `branchless`, blocks from both ends are compared first and only their offsets of
+// misplaced elements are recorded, by adding the result of the comparison instead of branching on
+// it (BlockQuicksort, Edelkamp and Weiss 2016). Then the misplaced elements are swapped in pairs.
+// Random input mispredicts half of the branches otherwise.
+template<bool branchless, typename It, typename Pred>
+It Partition(It first, It last, Pred pred) {
+    if constexpr(branchless) {
+        unsigned char offsets_l[partition_block_size], offsets_r[partition_block_size];
+        int start_l = 0, num_l = 0, start_r = 0, num_r = 0;
+        // Elements before `first` and from `last` on are in place, except for the recorded ones.
+        while(last - first >= 2 * partition_block_size) {
+            if(num_l == 0) {
+                start_l = 0;
+                for(int i = 0; i < partition_block_size; i++) {
+                    offsets_l[num_l] = i;
+                    num_l += !pred(first[i]);
+                }
+            }
+            if(num_r == 0) {
+                start_r = 0;
+                for(int i = 0; i < partition_block_size; i++) {
+                    offsets_r[num_r] = i;
+                    num_r += pred(*(last - 1 - i));
+                }
+            }
+            int num = min(num_l, num_r);
+            for(int i = 0; i < num; i++)
+                iter_swap(first + offsets_l[start_l + i], last - 1 - offsets_r[start_r + i]);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if(num_l == 0)
+                first += partition_block_size;
+            if(num_r == 0)
+                last -= partition_block_size;
+        }
+        // A block with misplaced elements left is just partitioned again below.
+    }
+    while(true) {
+        while(first != last && pred(*first))
+            ++first;
+        while(first != last && !pred(*(last - 1)))
+            --last;
+        if(first == last)
+            return first;
+        iter_swap(first, last - 1);
+        ++first;
+        --last;
+    }
+}
+
+// Partition [first, last) around the pivot at `*first`, and return its final position. With
+// `equal_left`, elements equal to the pivot go before it, otherwise after it.
+template<bool branchless, typename It, typename Compare>
+It PartitionAroundPivot(It first, It last, Compare comp, bool equal_left) {
+    auto pivot = move(*first);
+    It mid;
+    if(equal_left)
+        mid = Partition<false>(first + 1, last, [&](const auto &x) {
+            return !comp(pivot, x);
+        });
+    else
+        mid = Partition<branchless>(first + 1, last, [&](const auto &x) {
+            return comp(x, pivot);
+        });
+    --mid;
+    *first = move(*mid);
+    *mid = move(pivot);
+    return mid;
+}
+
+// Partition [first, last) once, and return the pivot position. `leftmost` is false when the
+// element before `first` belongs to the same sort and is no greater than any element in the range.
+// If it equals the pivot, equal elements are put on the left, where they are all equal to the
+// pivot and done, and `equal` is set. Few distinct keys are then O(n log k) rather than
+// O(n log n).
+template<typename It, typename Compare>
+It PartitionStep(It first, It last, Compare comp, bool leftmost, bool &equal) {
+    using T = typename iterator_traits<It>::value_type;
+    constexpr bool branchless = branchless_partition<T, Compare>;
+    ChoosePivot(first, last, comp);
+    equal = !leftmost && !comp(*(first - 1), *first);
+    return PartitionAroundPivot<branchless>(first, last, comp, equal);
+}
+
+template<typename It, typename Compare>
+void HeapSort(It first, It last, Compare comp) {
+    make_heap(first, last, comp);
+    sort_heap(first, last, comp);
+}
+
+// 2 floor(log2(n)), like `std::sort()`.
+inline int IntroSortDepth(size_t n) {
+    int depth = 0;
+    for(; n > 1; n >>= 1)
+        depth += 2;
+    return depth;
+}
+
+template<typename It, typename Compare>
+void IntroSortLoop(It first, It last, Compare comp, int depth, bool leftmost) {
+    while(last - first > insertion_sort_threshold) {
+        if(depth-- == 0) {
+            HeapSort(first, last, comp);
+            return;
+        }
+        bool equal;
+        It mid = PartitionStep(first, last, comp, leftmost, equal);
+        if(equal) {
+            first = mid + 1;
+            continue;
+        }
+        // Recurse into the smaller side and loop on the larger, so the stack is O(log n).
+        if(mid - first < last - mid) {
+            IntroSortLoop(first, mid, comp, depth, leftmost);
+            first = mid + 1;
+            leftmost = false;
+        } else {
+            IntroSortLoop(mid + 1, last, comp, depth, false);
+            last = mid;
+        }
+    }
+    InsertionSort(first, last, comp);
+}
+
+// Introsort: quicksort with a median-of-3 or ninther pivot, insertion sort for small ranges, and
+// heap sort once the recursion gets deeper than 2 log2(n), so the worst case is O(n log n) where
+// `QuickSort0()` and `QuickSort1()` go O(n^2). Arithmetic types with `less` or `greater` partition
+// without branches. Not stable.
+template<typename It, typename Compare = less<>>
+void IntroSort(It first, It last, Compare comp = Compare()) {
+    IntroSortLoop(first, last, comp, IntroSortDepth(last - first), true);
+}
+
+template<typename It, typename Compare>
+void ParallelIntroSortLoop(It first, It last, Compare comp, int depth, bool leftmost,
+                           ptrdiff_t grain, ThreadPool &pool) {
+    while(last - first > grain) {
+        if(depth-- == 0) {
+            HeapSort(first, last, comp);
+            return;
+        }
+        bool equal;
+        It mid = PartitionStep(first, last, comp, leftmost, equal);
+        if(equal) {
+            first = mid + 1;
+            continue;
+        }
+        pool.ParallelFor(2, [&](int i) {
+            if(i == 0)
+                ParallelIntroSortLoop(first, mid, comp, depth, leftmost, grain, pool);
+            else
+                ParallelIntroSortLoop(mid + 1, last, comp, depth, false, grain, pool);
+        });
+        return;
+    }
+    IntroSortLoop(first, last, comp, depth, leftmost);
+}
+
+// `IntroSort()` on `pool`: both sides of a partition are sorted as parallel tasks, down to ranges
+// of about n / (8 threads), which are sorted sequentially. The first partitions run on fewer
+// threads than the pool has, so the speedup is less than the thread count.
+template<typename It, typename Compare = less<>>
+void ParallelIntroSort(It first, It last, ThreadPool &pool, Compare comp = Compare()) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t grain = max(n / (8 * (pool.size() + 1)), ptrdiff_t(1) << 14);
+    if(pool.size() == 0)
+        grain = n;
+    ParallelIntroSortLoop(first, last, comp, IntroSortDepth(n), true, grain, pool);
+}
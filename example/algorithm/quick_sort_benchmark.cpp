@@ -0,0 +1,146 @@
+// Sorting: `std::sort()`, `QuickSort0()`, `QuickSort1()`, `IntroSort()` and `ParallelIntroSort()`
+// on random, sorted and few-unique inputs of `int` and `float`. `ParallelIntroSort()` is swept
+// across 1..N threads.
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "quick_sort.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 22;
+
+enum Distribution { random_keys, sorted_keys, few_unique_keys };
+
+template<typename T>
+const vector<T> &Input(Distribution distribution) {
+    static vector<T> inputs[3];
+    vector<T> &input = inputs[distribution];
+    if(input.empty()) {
+        mt19937 gen(0);
+        input.resize(n);
+        for(int i = 0; i < n; i++)
+            if(distribution == random_keys)
+                input[i] = T(gen() % (1 << 30));
+            else if(distribution == sorted_keys)
+                input[i] = T(i);
+            else
+                input[i] = T(gen() % 16);
+    }
+    return input;
+}
+
+// Sort a fresh copy of the input in each iteration. Copying isn't timed.
+template<typename T, typename Sort>
+void Run(benchmark::State &state, Distribution distribution, Sort sort) {
+    const vector<T> &input = Input<T>(distribution);
+    vector<T> a;
+    for(auto _: state) {
+        state.PauseTiming();
+        a = input;
+        state.ResumeTiming();
+        sort(a);
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Sequential. The last argument picks the element type. Items are elements.
+
+template<typename T>
+static void BM_StdSort(benchmark::State &state, Distribution distribution, T) {
+    Run<T>(state, distribution, [](vector<T> &a) {
+        sort(a.begin(), a.end());
+    });
+}
+BENCHMARK_CAPTURE(BM_StdSort, Random, random_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_StdSort, Sorted, sorted_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_StdSort, FewUnique, few_unique_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_StdSort, RandomFloat, random_keys, float())->Unit(benchmark::kMillisecond);
+
+static void BM_QuickSort0(benchmark::State &state, Distribution distribution) {
+    Run<int>(state, distribution, [](vector<int> &a) {
+        QuickSort0(a, 0, a.size() - 1);
+    });
+}
+BENCHMARK_CAPTURE(BM_QuickSort0, Random, random_keys)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_QuickSort0, Sorted, sorted_keys)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_QuickSort0, FewUnique, few_unique_keys)->Unit(benchmark::kMillisecond);
+
+static void BM_QuickSort1(benchmark::State &state, Distribution distribution) {
+    Run<int>(state, distribution, [](vector<int> &a) {
+        QuickSort1(a, 0, a.size() - 1);
+    });
+}
+BENCHMARK_CAPTURE(BM_QuickSort1, Random, random_keys)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_QuickSort1, Sorted, sorted_keys)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_QuickSort1, FewUnique, few_unique_keys)->Unit(benchmark::kMillisecond);
+
+template<typename T>
+static void BM_IntroSort(benchmark::State &state, Distribution distribution, T) {
+    Run<T>(state, distribution, [](vector<T> &a) {
+        IntroSort(a.begin(), a.end());
+    });
+}
+BENCHMARK_CAPTURE(BM_IntroSort, Random, random_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_IntroSort, Sorted, sorted_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_IntroSort, FewUnique, few_unique_keys, int())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_IntroSort, RandomFloat, random_keys, float())->Unit(benchmark::kMillisecond);
+
+/*------------------------------------------------------------------------------------------------*/
+// Parallel. `state.range(0)` is the thread count. Items are elements.
+
+static void BM_ParallelIntroSort(benchmark::State &state, Distribution distribution) {
+    ThreadPool pool(state.range(0) - 1);
+    Run<int>(state, distribution, [&](vector<int> &a) {
+        ParallelIntroSort(a.begin(), a.end(), pool);
+    });
+}
+BENCHMARK_CAPTURE(BM_ParallelIntroSort, Random, random_keys)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ParallelIntroSort, FewUnique, few_unique_keys)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+-----------------------------------------------------------------------------------------------------
+Benchmark                                           Time             CPU   Iterations UserCounters...
+-----------------------------------------------------------------------------------------------------
+BM_StdSort/Random                                 448 ms          439 ms            2 items_per_second=9.54435M/s
+BM_StdSort/Sorted                                81.7 ms         80.2 ms           10 items_per_second=52.3053M/s
+BM_StdSort/FewUnique                              149 ms          147 ms            5 items_per_second=28.5085M/s
+BM_StdSort/RandomFloat                            525 ms          508 ms            1 items_per_second=8.25214M/s
+BM_QuickSort0/Random                              617 ms          605 ms            1 items_per_second=6.93354M/s
+BM_QuickSort0/Sorted                             81.3 ms         79.6 ms            8 items_per_second=52.6628M/s
+BM_QuickSort0/FewUnique                           231 ms          227 ms            3 items_per_second=18.5117M/s
+BM_QuickSort1/Random                              657 ms          653 ms            1 items_per_second=6.42388M/s
+BM_QuickSort1/Sorted                              118 ms          116 ms            6 items_per_second=36.2329M/s
+BM_QuickSort1/FewUnique                           300 ms          297 ms            2 items_per_second=14.1389M/s
+BM_IntroSort/Random                               331 ms          324 ms            2 items_per_second=12.9495M/s
+BM_IntroSort/Sorted                               115 ms          113 ms            6 items_per_second=37.2259M/s
+BM_IntroSort/FewUnique                           52.6 ms         51.7 ms           14 items_per_second=81.1578M/s
+BM_IntroSort/RandomFloat                          310 ms          306 ms            2 items_per_second=13.6867M/s
+BM_ParallelIntroSort/Random/1/real_time           313 ms          308 ms            2 items_per_second=13.3902M/s
+BM_ParallelIntroSort/FewUnique/1/real_time       52.4 ms         51.6 ms           13 items_per_second=80.0364M/s
+*/
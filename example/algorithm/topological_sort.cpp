@@ -1,57 +1,45 @@
 #include <cassert>
 
-#include <iostream>
-#include <queue>
+#include <algorithm>
+#include <random>
 #include <vector>
 using namespace std;
 
-// Node indexes start from 0.
-class Graph {
-    int size_;
-    // Node `i` is linked to node `edges_[i][j]`.
-    vector<vector<int>> edges_; // Adjacency List.
+#include "topological_sort.hpp"
 
-public:
-    Graph(int size): size_(size) {
-        edges_.resize(size_);
-    }
-    void AddEdge(int a, int b) {
-        edges_[a].push_back(b);
-    }
-
-    int size() const {
-        return size_;
-    }
-    const vector<int> &edges(int k) const {
-        return edges_[k];
-    }
-};
-
-vector<int> TopologicalSort(const Graph &graph) {
+// Levels are a valid schedule: every edge goes to a later level, and there are as few levels as
+// possible, i.e. each node after level 0 has an edge from the level just before it.
+bool CheckLevels(const CSRDigraph &graph, const TopologicalOrder &levels) {
     int n = graph.size();
-    vector<int> in(n);
-    for(int i = 0; i < n; i++)
-        for(int k: graph.edges(i))
-            in[k]++;
-
-    queue<int> q;
-    for(int i = 0; i < n; i++)
-        if(in[i] == 0)
-            q.push(i);
-
-    vector<int> ans;
-    while(!q.empty()) {
-        int k = q.front();
-        ans.push_back(k);
-        q.pop();
+    if(int(levels.order.size()) != n || !levels.cycle.empty())
+        return false;
+    vector<int> level(n, -1);
+    for(int l = 0; l < levels.level_count(); l++)
+        for(int j = levels.level_begin[l]; j < levels.level_begin[l + 1]; j++)
+            level[levels.order[j]] = l;
+    vector<int> latest(n, -1); // Latest level of the predecessors.
+    for(int k = 0; k < n; k++)
         for(int i: graph.edges(k)) {
-            in[i]--;
-            if(in[i] == 0)
-                q.push(i);
+            if(level[k] >= level[i])
+                return false;
+            latest[i] = max(latest[i], level[k]);
         }
-    }
+    for(int k = 0; k < n; k++)
+        if(latest[k] != level[k] - 1)
+            return false;
+    return true;
+}
 
-    return ans;
+// Each node of the cycle has an edge to the next, and the last to the first.
+bool CheckCycle(const CSRDigraph &graph, const vector<int> &cycle) {
+    if(cycle.empty())
+        return false;
+    for(size_t j = 0; j < cycle.size(); j++) {
+        Span<int> edges = graph.edges(cycle[j]);
+        if(find(edges.begin(), edges.end(), cycle[(j + 1) % cycle.size()]) == edges.end())
+            return false;
+    }
+    return true;
 }
 
 int main() {
@@ -70,9 +58,7 @@ int main() {
             {3, 1},
         };
 
-        Graph graph(n);
-        for(const auto &e: edges)
-            graph.AddEdge(e.a, e.b);
+        CSRDigraph graph(n, edges);
 
         vector<int> ans = TopologicalSort(graph);
         assert(ans == vector<int>({4, 5, 2, 0, 3, 1}));
@@ -86,13 +72,58 @@ int main() {
             {2, 0},
         }; // A cycle.
 
-        Graph graph(n);
-        for(const auto &e: edges)
-            graph.AddEdge(e.a, e.b);
+        CSRDigraph graph(n, edges);
 
         vector<int> ans = TopologicalSort(graph);
         assert(ans.empty());
     }
 
+    // Levels, and the cycle, in parallel with several thread counts.
+    {
+        vector<Edge> edges{{5, 2}, {5, 0}, {4, 0}, {4, 1}, {2, 3}, {3, 1}};
+        CSRDigraph graph(6, edges);
+        TopologicalOrder levels = TopologicalLevels(graph);
+        assert(levels.level_begin == vector<int>({0, 2, 4, 5, 6}));
+        assert(CheckLevels(graph, levels));
+
+        edges.push_back({1, 2}); // 2 -> 3 -> 1 -> 2.
+        CSRDigraph cyclic(6, edges);
+        levels = TopologicalLevels(cyclic);
+        assert(levels.order == vector<int>({4, 5, 0}));
+        assert(levels.cycle.size() == 3 && CheckCycle(cyclic, levels.cycle));
+    }
+    mt19937 gen(0);
+    for(int t = 0; t < 200; t++) {
+        // Random DAGs, edges going from lower to higher ranks of a random permutation, with a
+        // back edge in half of them.
+        int n = gen() % 5000 + 1, m = gen() % (n * 4);
+        vector<int> rank(n);
+        for(int i = 0; i < n; i++)
+            rank[i] = i;
+        shuffle(rank.begin(), rank.end(), gen);
+        vector<Edge> edges;
+        for(int i = 0; i < m; i++) {
+            int a = gen() % n, b = gen() % n;
+            if(a != b)
+                edges.push_back({rank[min(a, b)], rank[max(a, b)]});
+        }
+        bool cyclic = t % 2 && !edges.empty();
+        if(cyclic)
+            edges.push_back({edges[0].b, edges[0].a});
+        CSRDigraph graph(n, edges);
+
+        ThreadPool pool(t % 4);
+        TopologicalOrder levels = TopologicalLevels(graph);
+        TopologicalOrder parallel = ParallelTopologicalLevels(graph, pool);
+        assert(parallel.level_begin == levels.level_begin);
+        if(cyclic) {
+            assert(CheckCycle(graph, levels.cycle) && CheckCycle(graph, parallel.cycle));
+            assert(TopologicalSort(graph).size() == levels.order.size());
+        } else {
+            assert(CheckLevels(graph, levels) && CheckLevels(graph, parallel));
+            assert(TopologicalSort(graph).size() == size_t(n));
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// An unweighted directed graph in CSR form, see `CSRGraph`. Node indexes are [0, size()).
+// Edge targets are plain `int`s, half the size of `Rela`s, as dependency graphs have no weights.
+class CSRDigraph {
+    int size_;
+    vector<int> offsets_; // size_ + 1 elements.
+    vector<int> edges_;
+
+public:
+    // `edges` is any container of `{a, b}` structs, for edges from `a` to `b`.
+    template<typename Edges>
+    CSRDigraph(int size, const Edges &edges): size_(size), offsets_(size + 1) {
+        for(const auto &e: edges)
+            offsets_[e.a + 1]++;
+        for(int i = 1; i <= size_; i++)
+            offsets_[i] += offsets_[i - 1];
+        edges_.resize(offsets_[size_]);
+        vector<int> cursor(offsets_.begin(), offsets_.end() - 1);
+        for(const auto &e: edges)
+            edges_[cursor[e.a]++] = e.b;
+    }
+
+    int size() const {
+        return size_;
+    }
+    size_t edge_count() const {
+        return edges_.size();
+    }
+    Span<int> edges(int k) const {
+        return {edges_.data() + offsets_[k], edges_.data() + offsets_[k + 1]};
+    }
+};
+
+// Kahn's algorithm. Returns the nodes in topological order, or only those before the first cycle
+// if there is one.
+inline vector<int> TopologicalSort(const CSRDigraph &graph) {
+    int n = graph.size();
+    vector<int> in(n);
+    for(int i = 0; i < n; i++)
+        for(int k: graph.edges(i))
+            in[k]++;
+
+    queue<int> q;
+    for(int i = 0; i < n; i++)
+        if(in[i] == 0)
+            q.push(i);
+
+    vector<int> ans;
+    while(!q.empty()) {
+        int k = q.front();
+        ans.push_back(k);
+        q.pop();
+        for(int i: graph.edges(k)) {
+            in[i]--;
+            if(in[i] == 0)
+                q.push(i);
+        }
+    }
+
+    return ans;
+}
+
+// Nodes by level, for scheduling: level 0 is the nodes without incoming edges, and level i + 1 the
+// nodes whose last predecessor is in level i. The nodes of a level don't depend on each other, so
+// each level can run in parallel once the previous one is done.
+struct TopologicalOrder {
+    vector<int> order; // All nodes, level by level, if there is no cycle.
+    // Level i is `order[level_begin[i]]` to `order[level_begin[i + 1] - 1]`.
+    vector<int> level_begin;
+    // Empty if the graph is acyclic. Otherwise the nodes of a cycle, each with an edge to the next
+    // and the last to the first, and `order` has only the nodes before the cycles.
+    vector<int> cycle;
+
+    int level_count() const {
+        return level_begin.size() - 1;
+    }
+};
+
+// Called when Kahn's algorithm stops with nodes left, those with `in[k] > 0`. Each of them has an
+// edge from another one, so a depth-first search among them finds a cycle.
+template<typename InDegree>
+vector<int> FindCycle(const CSRDigraph &graph, const InDegree &in) {
+    enum { white, gray, black };
+    vector<char> color(graph.size(), white);
+    vector<pair<int, int>> stack; // `{node, next edge}` on the current path.
+    for(int start = 0; start < graph.size(); start++) {
+        if(in[start] == 0 || color[start] != white)
+            continue;
+        stack.push_back({start, 0});
+        color[start] = gray;
+        while(!stack.empty()) {
+            auto &[k, i] = stack.back();
+            Span<int> edges = graph.edges(k);
+            if(i == int(edges.size())) {
+                color[k] = black;
+                stack.pop_back();
+                continue;
+            }
+            int next = edges[i++];
+            if(in[next] == 0 || color[next] == black)
+                continue;
+            if(color[next] == gray) {
+                vector<int> cycle;
+                for(size_t j = stack.size(); stack[--j].first != next;)
+                    cycle.push_back(stack[j].first);
+                cycle.push_back(next);
+                reverse(cycle.begin(), cycle.end());
+                return cycle;
+            }
+            color[next] = gray;
+            stack.push_back({next, 0});
+        }
+    }
+    return {};
+}
+
+// Kahn's algorithm, level by level.
+inline TopologicalOrder TopologicalLevels(const CSRDigraph &graph) {
+    int n = graph.size();
+    vector<int> in(n);
+    for(int i = 0; i < n; i++)
+        for(int k: graph.edges(i))
+            in[k]++;
+
+    // `order` has room for all nodes, and `size` of them so far.
+    TopologicalOrder levels;
+    levels.order.resize(n);
+    size_t size = 0;
+    for(int i = 0; i < n; i++)
+        if(in[i] == 0)
+            levels.order[size++] = i;
+    levels.level_begin.push_back(0);
+    for(size_t begin = 0, end; begin < size; begin = end) {
+        end = size;
+        levels.level_begin.push_back(end);
+        for(size_t j = begin; j < end; j++)
+            for(int k: graph.edges(levels.order[j]))
+                if(--in[k] == 0)
+                    levels.order[size++] = k;
+    }
+    levels.order.resize(size);
+    if(int(size) < n)
+        levels.cycle = FindCycle(graph, in);
+    return levels;
+}
+
+// Adds `d` to `x` atomically and returns the new value, like C++20 `atomic_ref`. The in-degrees are
+// plain `int`s, since even relaxed loads and stores of `atomic<int>` aren't optimized like plain
+// ones, which made the levels run by one thread about 25% slower.
+inline int AtomicAdd(int &x, int d) {
+#ifdef _MSC_VER
+    return _InterlockedExchangeAdd(reinterpret_cast<volatile long *>(&x), d) + d;
+#else
+    return __atomic_add_fetch(&x, d, __ATOMIC_RELAXED);
+#endif
+}
+
+// `TopologicalLevels()` on `pool`, level-synchronous: the nodes of each level are split into
+// chunks, which decrement the in-degrees of their successors atomically. The chunk whose decrement
+// reaches 0 puts the successor in its own buffer for the next level, so each node is added once,
+// without locks. Then the buffers are copied after each other in parallel.
+// Levels of one chunk, which are all levels of deep graphs and of any graph on one thread, run on
+// the calling thread without atomic read-modify-writes or buffers.
+// Same levels as `TopologicalLevels()`, though the order within a level may differ.
+inline TopologicalOrder ParallelTopologicalLevels(const CSRDigraph &graph, ThreadPool &pool) {
+    int n = graph.size();
+    vector<vector<int>> chunks(pool.size() ? (pool.size() + 1) * 4 : 1);
+    // Chunks of at least 256 nodes.
+    auto chunk_count = [&](size_t size) {
+        return int(min<size_t>(chunks.size(), (size + 255) / 256));
+    };
+    // Run `f(i, chunk)` for each i in [begin, end), split into `n_chunk` chunks.
+    auto for_each_chunk = [&](size_t begin, size_t end, int n_chunk, auto f) {
+        pool.ParallelFor(n_chunk, [&](int c) {
+            size_t first = begin + (end - begin) * c / n_chunk;
+            size_t last = begin + (end - begin) * (c + 1) / n_chunk;
+            for(size_t i = first; i < last; i++)
+                f(i, chunks[c]);
+        });
+    };
+
+    TopologicalOrder levels;
+    levels.order.resize(n);
+    size_t size = 0; // Of `levels.order` so far.
+    // Append the chunks to `levels.order`, and clear them.
+    vector<size_t> offsets(chunks.size() + 1);
+    auto append_chunks = [&](int n_chunk) {
+        offsets[0] = size;
+        for(int c = 0; c < n_chunk; c++)
+            offsets[c + 1] = offsets[c] + chunks[c].size();
+        pool.ParallelFor(n_chunk, [&](int c) {
+            copy(chunks[c].begin(), chunks[c].end(), levels.order.begin() + offsets[c]);
+            chunks[c].clear();
+        });
+        size = offsets[n_chunk];
+    };
+
+    vector<int> in(n);
+    int n_chunk = chunk_count(n);
+    for_each_chunk(0, n, n_chunk, [&](int k, vector<int> &) {
+        for(int i: graph.edges(k))
+            if(n_chunk == 1)
+                in[i]++;
+            else
+                AtomicAdd(in[i], 1);
+    });
+    for_each_chunk(0, n, n_chunk, [&](int k, vector<int> &chunk) {
+        if(in[k] == 0)
+            chunk.push_back(k);
+    });
+    append_chunks(n_chunk);
+    levels.level_begin.push_back(0);
+    for(size_t begin = 0, end; begin < size; begin = end) {
+        end = size;
+        levels.level_begin.push_back(end);
+        n_chunk = chunk_count(end - begin);
+        if(n_chunk == 1) {
+            // Through locals, which stay in registers, unlike the variables the tasks refer to.
+            int *order = levels.order.data(), *degree = in.data();
+            size_t tail = size;
+            for(size_t j = begin; j < end; j++)
+                for(int i: graph.edges(order[j]))
+                    if(--degree[i] == 0)
+                        order[tail++] = i;
+            size = tail;
+            continue;
+        }
+        for_each_chunk(begin, end, n_chunk, [&](size_t j, vector<int> &chunk) {
+            for(int i: graph.edges(levels.order[j]))
+                if(AtomicAdd(in[i], -1) == 0)
+                    chunk.push_back(i);
+        });
+        append_chunks(n_chunk);
+    }
+    levels.order.resize(size);
+    if(int(size) < n)
+        levels.cycle = FindCycle(graph, in);
+    return levels;
+}
@@ -0,0 +1,105 @@
+// Topological sort: `TopologicalSort()`, `TopologicalLevels()` and `ParallelTopologicalLevels()` on
+// a wide DAG (few levels of many nodes) and a deep one (many levels of few nodes).
+// `ParallelTopologicalLevels()` is swept across 1..N threads.
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "topological_sort.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 21;
+constexpr int degree = 4;
+
+struct Edge {
+    int a, b;
+};
+
+// `n` nodes in levels of `width`, each with `degree` edges to random nodes of the next level.
+// Node indexes are shuffled, as tasks aren't numbered by level.
+const CSRDigraph &LayeredDAG(bool wide) {
+    static vector<CSRDigraph> graphs;
+    if(graphs.empty())
+        for(int width: {1 << 17, 1 << 4}) {
+            mt19937 gen(width);
+            vector<int> index(n);
+            for(int i = 0; i < n; i++)
+                index[i] = i;
+            shuffle(index.begin(), index.end(), gen);
+            vector<Edge> edges;
+            for(int i = 0; i + width < n; i++) {
+                int next_level = (i / width + 1) * width;
+                for(int j = 0; j < degree; j++)
+                    edges.push_back({index[i], index[next_level + gen() % width]});
+            }
+            graphs.emplace_back(n, edges);
+        }
+    return graphs[wide ? 0 : 1];
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Items are nodes.
+
+static void BM_TopologicalSort(benchmark::State &state, bool wide) {
+    const CSRDigraph &graph = LayeredDAG(wide);
+    for(auto _: state)
+        benchmark::DoNotOptimize(TopologicalSort(graph));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_CAPTURE(BM_TopologicalSort, Wide, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_TopologicalSort, Deep, false)->Unit(benchmark::kMillisecond);
+
+static void BM_TopologicalLevels(benchmark::State &state, bool wide) {
+    const CSRDigraph &graph = LayeredDAG(wide);
+    for(auto _: state)
+        benchmark::DoNotOptimize(TopologicalLevels(graph));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_CAPTURE(BM_TopologicalLevels, Wide, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_TopologicalLevels, Deep, false)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` is the thread count.
+static void BM_ParallelTopologicalLevels(benchmark::State &state, bool wide) {
+    const CSRDigraph &graph = LayeredDAG(wide);
+    ThreadPool pool(state.range(0) - 1);
+    for(auto _: state)
+        benchmark::DoNotOptimize(ParallelTopologicalLevels(graph, pool));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_CAPTURE(BM_ParallelTopologicalLevels, Wide, true)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ParallelTopologicalLevels, Deep, false)
+    ->RangeMultiplier(2)
+    ->Range(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------------------------
+Benchmark                                              Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------------------------
+BM_TopologicalSort/Wide                              317 ms          314 ms            2 items_per_second=6.67583M/s
+BM_TopologicalSort/Deep                              326 ms          323 ms            2 items_per_second=6.49355M/s
+BM_TopologicalLevels/Wide                            244 ms          242 ms            3 items_per_second=8.65761M/s
+BM_TopologicalLevels/Deep                            263 ms          261 ms            3 items_per_second=8.0199M/s
+BM_ParallelTopologicalLevels/Wide/1/real_time        248 ms          246 ms            3 items_per_second=8.45235M/s
+BM_ParallelTopologicalLevels/Deep/1/real_time        256 ms          253 ms            3 items_per_second=8.1772M/s
+*/
@@ -2,98 +2,14 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 
 #include <limits>
+#include <random>
 #include <vector>
 using namespace std;
 
-// BinaryIndexedTree only processes the range [1, n] and index 0 is ignored.
-// Values/Indexes should be mapped/offset to the range [1, n].
-class BinaryIndexedTree {
-    vector<int> v_;
-    size_t high_;
-
-public:
-    // `n` is the size of the range.
-    // e.g. `n == 5` for [-2, 2] which is mapped to [1, 5].
-    BinaryIndexedTree(size_t n) {
-        high_ = n ? 1 << (size_t)log2(n) : 0;
-        v_ = vector<int>(n + 1);
-    }
-
-    // O(n) initialization
-    BinaryIndexedTree(const vector<int> &v) {
-        size_t n = v.size() - 1;
-        high_ = n ? 1 << (size_t)log2(n) : 0;
-        v_ = v;
-        for(size_t i = 1; i <= n; i++) {
-            size_t j = i + (i & -i);
-            if(j <= n)
-                v_[j] += v_[i];
-        }
-    }
-
-    // O(nlogn) initialization
-    // BinaryIndexedTree(const vector<int> &v) {
-    //     size_ = v.size() - 1;
-    //     high_ = size_ ? 1 << (size_t)log2(size_) : 0;
-    //     v_ = vector<int>(size_ + 1);
-    //     for(size_t i = 1; i <= size_; i++)
-    //         Update(i, v[i]);
-    // }
-
-    void Update(size_t i, int d) {
-        for(; i < v_.size(); i += i & -i)
-            v_[i] += d;
-    }
-
-    int PrefixSum(size_t i) {
-        int result = 0;
-        for(; i >= 1; i -= i & -i)
-            result += v_[i];
-        return result;
-    }
-
-    int RangeSum(size_t from, size_t to) {
-        return PrefixSum(to) - PrefixSum(from - 1);
-    }
-
-    // Find the maximum index i such that PrefixSum(i) == s.
-    // Return 0 if no such PrefixSum exists.
-    int FindPrefixSumMax(int s) {
-        size_t i = 0;
-        for(size_t t = high_; t; t >>= 1) {
-            size_t j = i + t;
-            if(j < v_.size() && s >= v_[j]) {
-                s -= v_[j];
-                i = j;
-            }
-        }
-        if(s)
-            return 0;
-        else
-            return static_cast<int>(i);
-    }
-
-    // Find the minimum index i such that PrefixSum(i) == s.
-    // Return 0 if no such PrefixSum exists.
-    int FindPrefixSumMin(int S) {
-        size_t i = 0;
-        int s = S - 1;
-        for(size_t t = high_; t; t >>= 1) {
-            size_t j = i + t;
-            if(j < v_.size() && s >= v_[j]) {
-                s -= v_[j];
-                i = j;
-            }
-        }
-        int j = FindPrefixSumMax(S);
-        if(j == 0)
-            return 0;
-        else
-            return static_cast<int>(i + 1);
-    }
-};
+#include "binary_indexed_tree.hpp"
 
 int main() {
     // Index 0 is ignored.
@@ -159,6 +75,86 @@ int main() {
     assert(bit.FindPrefixSumMin(0) == 1);
     assert(bit.FindPrefixSumMin(4) == 5);
 
+    mt19937 gen(0);
+
+    // `UpdateMany()`, with few updates walking the tree and many updates rebuilding it, against
+    // `Update()` one by one.
+    for(int t = 0; t < 100; t++) {
+        size_t n = gen() % 1000 + 1;
+        BinaryIndexedTree<int64_t> a(n), b(n);
+        for(int round = 0; round < 3; round++) {
+            vector<pair<size_t, int64_t>> updates(gen() % (t % 2 ? 10 : n * 2));
+            for(auto &[i, d]: updates) {
+                i = gen() % n + 1;
+                d = int64_t(gen() % 2000) - 1000;
+                a.Update(i, d);
+            }
+            b.UpdateMany(updates);
+            for(size_t i = 1; i <= n; i++)
+                assert(a.PrefixSum(i) == b.PrefixSum(i));
+        }
+    }
+
+    // Range updates and range sums against an array.
+    for(int t = 0; t < 100; t++) {
+        size_t n = gen() % 200 + 1;
+        RangeBinaryIndexedTree<int64_t> bit(n);
+        vector<int64_t> a(n + 1);
+        for(int op = 0; op < 200; op++) {
+            size_t l = gen() % n + 1, r = gen() % n + 1;
+            if(l > r)
+                swap(l, r);
+            if(op % 2) {
+                int64_t d = int64_t(gen() % 2000) - 1000;
+                bit.RangeUpdate(l, r, d);
+                for(size_t i = l; i <= r; i++)
+                    a[i] += d;
+            } else {
+                int64_t sum = 0;
+                for(size_t i = l; i <= r; i++)
+                    sum += a[i];
+                assert(bit.RangeSum(l, r) == sum);
+            }
+        }
+    }
+
+    // 2-D and 3-D, against arrays.
+    {
+        BinaryIndexedTree2D<double> bit({3, 4});
+        bit.Update({1, 1}, 1.5);
+        bit.Update({2, 3}, 2);
+        bit.Update({3, 4}, 4);
+        assert(bit.PrefixSum({2, 3}) == 3.5);
+        assert(bit.RangeSum({2, 2}, {3, 4}) == 6);
+        assert(bit.RangeSum({1, 2}, {3, 3}) == 2);
+    }
+    for(int t = 0; t < 50; t++) {
+        size_t x = gen() % 8 + 1, y = gen() % 8 + 1, z = gen() % 8 + 1;
+        BinaryIndexedTree3D<int> bit({x, y, z});
+        vector<int> a((x + 1) * (y + 1) * (z + 1));
+        auto at = [&](size_t i, size_t j, size_t k) -> int & {
+            return a[(i * (y + 1) + j) * (z + 1) + k];
+        };
+        for(int op = 0; op < 100; op++) {
+            size_t i0 = gen() % x + 1, j0 = gen() % y + 1, k0 = gen() % z + 1;
+            size_t i1 = gen() % x + 1, j1 = gen() % y + 1, k1 = gen() % z + 1;
+            if(op % 2) {
+                int d = int(gen() % 100) - 50;
+                bit.Update({i0, j0, k0}, d);
+                at(i0, j0, k0) += d;
+            } else {
+                int sum = 0;
+                for(size_t i = min(i0, i1); i <= max(i0, i1); i++)
+                    for(size_t j = min(j0, j1); j <= max(j0, j1); j++)
+                        for(size_t k = min(k0, k1); k <= max(k0, k1); k++)
+                            sum += at(i, j, k);
+                assert(bit.RangeSum({min(i0, i1), min(j0, j1), min(k0, k1)},
+                                    {max(i0, i1), max(j0, j1), max(k0, k1)})
+                       == sum);
+            }
+        }
+    }
+
     assert(log2(0) == -numeric_limits<float>::infinity());
     assert((int)log2(0) == numeric_limits<int>::min());
     assert((int)log2(7) == 2);
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// BinaryIndexedTree only processes the range [1, n] and index 0 is ignored.
+// Values/Indexes should be mapped/offset to the range [1, n].
+// `T` is the value type, e.g. `int`, `int64_t`, `float` or `double`.
+template<typename T = int>
+class BinaryIndexedTree {
+    std::vector<T> v_;
+    size_t high_;
+
+public:
+    // `n` is the size of the range.
+    // e.g. `n == 5` for [-2, 2] which is mapped to [1, 5].
+    BinaryIndexedTree(size_t n) {
+        high_ = n ? 1 << (size_t)log2(n) : 0;
+        v_ = std::vector<T>(n + 1);
+    }
+
+    // O(n) initialization
+    BinaryIndexedTree(const std::vector<T> &v) {
+        size_t n = v.size() - 1;
+        high_ = n ? 1 << (size_t)log2(n) : 0;
+        v_ = v;
+        for(size_t i = 1; i <= n; i++) {
+            size_t j = i + (i & -i);
+            if(j <= n)
+                v_[j] += v_[i];
+        }
+    }
+
+    // O(nlogn) initialization
+    // BinaryIndexedTree(const std::vector<T> &v) {
+    //     size_ = v.size() - 1;
+    //     high_ = size_ ? 1 << (size_t)log2(size_) : 0;
+    //     v_ = std::vector<T>(size_ + 1);
+    //     for(size_t i = 1; i <= size_; i++)
+    //         Update(i, v[i]);
+    // }
+
+    void Update(size_t i, T d) {
+        for(; i < v_.size(); i += i & -i)
+            v_[i] += d;
+    }
+
+    // `Update(i, d)` for each `{i, d}` in `updates`.
+    // When there are so many updates that their walks would touch the whole array a few times over,
+    // the deltas are summed into a second array by index, which is turned into a tree in O(n) like
+    // the initialization and added element-wise in one sequential pass.
+    void UpdateMany(const std::vector<std::pair<size_t, T>> &updates) {
+        size_t n = v_.size() - 1;
+        size_t log_n = high_ ? (size_t)log2(high_) + 1 : 1;
+        if(updates.size() * log_n < 2 * n) {
+            for(const auto &[i, d]: updates)
+                Update(i, d);
+            return;
+        }
+        std::vector<T> d(n + 1);
+        for(const auto &[i, delta]: updates)
+            d[i] += delta;
+        for(size_t i = 1; i <= n; i++) {
+            size_t j = i + (i & -i);
+            if(j <= n)
+                d[j] += d[i];
+            v_[i] += d[i];
+        }
+    }
+
+    T PrefixSum(size_t i) {
+        T result = 0;
+        for(; i >= 1; i -= i & -i)
+            result += v_[i];
+        return result;
+    }
+
+    T RangeSum(size_t from, size_t to) {
+        return PrefixSum(to) - PrefixSum(from - 1);
+    }
+
+    // Find the maximum index i such that PrefixSum(i) == s.
+    // Return 0 if no such PrefixSum exists.
+    int FindPrefixSumMax(T s) {
+        size_t i = 0;
+        for(size_t t = high_; t; t >>= 1) {
+            size_t j = i + t;
+            if(j < v_.size() && s >= v_[j]) {
+                s -= v_[j];
+                i = j;
+            }
+        }
+        if(s)
+            return 0;
+        else
+            return static_cast<int>(i);
+    }
+
+    // Find the minimum index i such that PrefixSum(i) == s.
+    // Return 0 if no such PrefixSum exists.
+    int FindPrefixSumMin(T S) {
+        size_t i = 0;
+        T s = S - 1;
+        for(size_t t = high_; t; t >>= 1) {
+            size_t j = i + t;
+            if(j < v_.size() && s >= v_[j]) {
+                s -= v_[j];
+                i = j;
+            }
+        }
+        int j = FindPrefixSumMax(S);
+        if(j == 0)
+            return 0;
+        else
+            return static_cast<int>(i + 1);
+    }
+};
+
+// Range update and range sum, with two trees.
+// Adding `d` to [l, r] makes the prefix sum of `i` grow by `d * (i - l + 1)` for `i` in [l, r], and
+// by `d * (r - l + 1)` after `r`. So with `b` as the difference array of the values and `c[i]` as
+// `b[i] * (i - 1)`, the prefix sum of `i` is `PrefixSum(b, i) * i - PrefixSum(c, i)`, and a range
+// update is 2 point updates of each.
+// The two trees are interleaved, so each walk updates or reads both at once.
+template<typename T = int>
+class RangeBinaryIndexedTree {
+    struct Node {
+        T b, c;
+    };
+    std::vector<Node> v_;
+
+    void Update(size_t i, T b, T c) {
+        for(; i < v_.size(); i += i & -i) {
+            v_[i].b += b;
+            v_[i].c += c;
+        }
+    }
+
+public:
+    // `n` is the size of the range [1, n].
+    RangeBinaryIndexedTree(size_t n): v_(n + 1) {}
+
+    // Add `d` to [from, to].
+    void RangeUpdate(size_t from, size_t to, T d) {
+        Update(from, d, d * T(from - 1));
+        Update(to + 1, -d, -d * T(to));
+    }
+
+    T PrefixSum(size_t i) {
+        T b = 0, c = 0;
+        for(size_t j = i; j >= 1; j -= j & -j) {
+            b += v_[j].b;
+            c += v_[j].c;
+        }
+        return b * T(i) - c;
+    }
+
+    T RangeSum(size_t from, size_t to) {
+        return PrefixSum(to) - PrefixSum(from - 1);
+    }
+};
+
+// `D`-dimensional tree, e.g. a 2-D or 3-D heatmap of counters.
+// Each dimension only processes [1, n] like `BinaryIndexedTree`. Nodes are stored in one array,
+// with the last dimension contiguous. The loops over dimensions are unrolled at compile time.
+// Update and prefix sum are O(log^D n), and a range sum is 2^D prefix sums.
+template<typename T, int D>
+class MultiBinaryIndexedTree {
+    using Index = std::array<size_t, D>;
+
+    Index n_;
+    Index stride_;
+    std::vector<T> v_;
+
+    template<int d>
+    void Update(size_t offset, const Index &index, T delta) {
+        for(size_t i = index[d]; i <= n_[d]; i += i & -i) {
+            if constexpr(d + 1 == D)
+                v_[offset + i] += delta;
+            else
+                Update<d + 1>(offset + i * stride_[d], index, delta);
+        }
+    }
+
+    template<int d>
+    T PrefixSum(size_t offset, const Index &index) const {
+        T result = 0;
+        for(size_t i = index[d]; i >= 1; i -= i & -i) {
+            if constexpr(d + 1 == D)
+                result += v_[offset + i];
+            else
+                result += PrefixSum<d + 1>(offset + i * stride_[d], index);
+        }
+        return result;
+    }
+
+public:
+    // `n[d]` is the size of dimension `d`.
+    MultiBinaryIndexedTree(const Index &n): n_(n) {
+        size_t size = 1;
+        for(int d = D - 1; d >= 0; d--) {
+            stride_[d] = size;
+            size *= n_[d] + 1;
+        }
+        v_.resize(size);
+    }
+
+    void Update(const Index &index, T delta) {
+        Update<0>(0, index, delta);
+    }
+
+    // Sum of the box [1, index[0]] x [1, index[1]] x ...
+    T PrefixSum(const Index &index) const {
+        return PrefixSum<0>(0, index);
+    }
+
+    // Sum of the box [from[0], to[0]] x [from[1], to[1]] x ..., by inclusion-exclusion of the
+    // prefix sums of its corners.
+    T RangeSum(const Index &from, const Index &to) const {
+        T result = 0;
+        for(int corner = 0; corner < 1 << D; corner++) {
+            Index index;
+            bool negative = false;
+            for(int d = 0; d < D; d++) {
+                bool low = corner >> d & 1;
+                index[d] = low ? from[d] - 1 : to[d];
+                negative ^= low;
+            }
+            T sum = PrefixSum(index);
+            result += negative ? -sum : sum;
+        }
+        return result;
+    }
+};
+
+template<typename T = int>
+using BinaryIndexedTree2D = MultiBinaryIndexedTree<T, 2>;
+template<typename T = int>
+using BinaryIndexedTree3D = MultiBinaryIndexedTree<T, 3>;
@@ -1,41 +1,11 @@
 #include <cassert>
+
+#include <random>
+#include <thread>
 #include <vector>
 using namespace std;
 
-class DisjointSets {
-    std::vector<int> parent_;
-    std::vector<int> rank_;
-
-    int Find(int x) {
-        if(parent_[x] == x)
-            return x;
-        else
-            return parent_[x] = Find(parent_[x]);
-    }
-
-public:
-    // Indexes start from 0 or 1.
-    DisjointSets(int size): parent_(size + 1), rank_(size + 1) {
-        for(int i = 0; i <= size; i++)
-            parent_[i] = i;
-    }
-
-    void Unite(int x0, int x1) {
-        int f0 = Find(x0);
-        int f1 = Find(x1);
-        if(rank_[f0] > rank_[f1]) {
-            parent_[f1] = f0;
-        } else {
-            parent_[f0] = f1;
-            if(rank_[f0] == rank_[f1])
-                rank_[f1]++;
-        }
-    }
-
-    bool IsSame(int x0, int x1) {
-        return Find(x0) == Find(x1);
-    }
-};
+#include "disjoint_sets.hpp"
 
 int main() {
     vector<vector<int>> sets = {
@@ -52,5 +22,64 @@ int main() {
     assert(ds.IsSame(0, 6) == true);
     assert(ds.IsSame(0, 1) == false);
 
+    {
+        ConcurrentDisjointSets cds(8);
+        for(auto &s: sets)
+            for(size_t i = 1; i < s.size(); i++)
+                cds.Unite(s[0], s[i]);
+
+        assert(cds.IsSame(0, 6) == true);
+        assert(cds.IsSame(0, 1) == false);
+        assert(cds.Unite(3, 6) == false);
+        assert(cds.Unite(3, 4) == true);
+        assert(cds.IsSame(0, 7) == true);
+        assert(cds.CountSets() == 3); // {0, 1, 3, 4, 6, 7}, {2, 5}, {8}.
+        vector<int> labels = cds.Labels();
+        assert(labels[0] == labels[7] && labels[2] == labels[5] && labels[0] != labels[2]);
+    }
+
+    // Random unions from several threads at once, against `DisjointSets` doing the same unions.
+    mt19937 gen(0);
+    for(int t = 0; t < 20; t++) {
+        int n = gen() % 10000 + 1;
+        int n_thread = 4;
+        vector<vector<pair<int, int>>> unions(n_thread);
+        for(auto &u: unions)
+            for(int i = gen() % n; i > 0; i--)
+                u.push_back({gen() % n + 1, gen() % n + 1});
+
+        DisjointSets ds(n);
+        for(auto &u: unions)
+            for(auto [a, b]: u)
+                if(!ds.IsSame(a, b))
+                    ds.Unite(a, b);
+
+        ConcurrentDisjointSets cds(n);
+        vector<thread> threads;
+        for(int i = 0; i < n_thread; i++)
+            threads.emplace_back([&, i] {
+                mt19937 gen(i);
+                for(auto [a, b]: unions[i]) {
+                    cds.Unite(a, b);
+                    cds.IsSame(a, gen() % n + 1); // Finds racing with unions.
+                }
+            });
+        for(auto &thread: threads)
+            thread.join();
+
+        for(int i = 0; i < 1000; i++) {
+            int a = gen() % n + 1, b = gen() % n + 1;
+            assert(cds.IsSame(a, b) == ds.IsSame(a, b));
+        }
+        vector<int> labels = cds.Labels();
+        int count = 0;
+        for(int i = 0; i <= n; i++) {
+            count += labels[i] == i;
+            assert(labels[i] == cds.Find(i));
+            assert(ds.IsSame(i, labels[i]));
+        }
+        assert(count == cds.CountSets());
+    }
+
     return 0;
 }
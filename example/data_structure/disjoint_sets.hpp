@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class DisjointSets {
+    std::vector<int> parent_;
+    std::vector<int> rank_;
+
+    // Path compression in two passes instead of recursion.
+    int Find(int x) {
+        int root = x;
+        while(parent_[root] != root)
+            root = parent_[root];
+        while(parent_[x] != root) {
+            int next = parent_[x];
+            parent_[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+public:
+    // Indexes start from 0 or 1.
+    DisjointSets(int size): parent_(size + 1), rank_(size + 1) {
+        for(int i = 0; i <= size; i++)
+            parent_[i] = i;
+    }
+
+    void Unite(int x0, int x1) {
+        int f0 = Find(x0);
+        int f1 = Find(x1);
+        if(rank_[f0] > rank_[f1]) {
+            parent_[f1] = f0;
+        } else {
+            parent_[f0] = f1;
+            if(rank_[f0] == rank_[f1])
+                rank_[f1]++;
+        }
+    }
+
+    bool IsSame(int x0, int x1) {
+        return Find(x0) == Find(x1);
+    }
+};
+
+// Disjoint sets which may be used by many threads at once, without locks.
+// A root is linked under another with a CAS on its parent, which fails if it's no longer a root,
+// and then `Unite()` retries from the new roots. Roots are linked in a fixed pseudo-random order
+// of indexes instead of by rank, which keeps trees shallow in expectation and needs no extra word
+// per node to update atomically. `Find()` does path splitting, i.e. points each node on the path
+// to its grandparent, also by CAS, and a failed CAS only means another thread has changed the
+// path already. `Find()` and `IsSame()` never block, and `Unite()` only retries when another
+// `Unite()` has succeeded.
+class ConcurrentDisjointSets {
+    std::vector<std::atomic<int>> parent_;
+
+    // A bijection on 32-bit integers, i.e. a fixed pseudo-random order of indexes.
+    static uint32_t Priority(int x) {
+        return uint32_t(x) * 2654435761u;
+    }
+
+public:
+    // Indexes start from 0 or 1.
+    ConcurrentDisjointSets(int size): parent_(size + 1) {
+        for(int i = 0; i <= size; i++)
+            parent_[i].store(i, std::memory_order_relaxed);
+    }
+
+    int Find(int x) {
+        while(true) {
+            int p = parent_[x].load(std::memory_order_relaxed);
+            int gp = parent_[p].load(std::memory_order_relaxed);
+            if(p == gp)
+                return p;
+            parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            x = p;
+        }
+    }
+
+    // Return whether `x0` and `x1` were in different sets.
+    bool Unite(int x0, int x1) {
+        while(true) {
+            x0 = Find(x0);
+            x1 = Find(x1);
+            if(x0 == x1)
+                return false;
+            if(Priority(x0) > Priority(x1))
+                std::swap(x0, x1);
+            int expected = x0;
+            if(parent_[x0].compare_exchange_strong(expected, x1))
+                return true;
+        }
+    }
+
+    bool IsSame(int x0, int x1) {
+        while(true) {
+            x0 = Find(x0);
+            x1 = Find(x1);
+            if(x0 == x1)
+                return true;
+            // Still a root, so `x0` and `x1` were in different sets when `x1` was found.
+            if(parent_[x0].load() == x0)
+                return false;
+        }
+    }
+
+    // The number of sets, counting index 0 even if indexes start from 1.
+    // Exact if no `Unite()` runs at the same time, otherwise somewhere between the counts before
+    // and after the concurrent `Unite()`s.
+    int CountSets() const {
+        int count = 0;
+        for(size_t i = 0; i < parent_.size(); i++)
+            count += parent_[i].load(std::memory_order_relaxed) == int(i);
+        return count;
+    }
+
+    // The root of each index, so `labels[x0] == labels[x1]` iff `IsSame(x0, x1)`.
+    // Exact if no `Unite()` runs at the same time.
+    std::vector<int> Labels() {
+        std::vector<int> labels(parent_.size());
+        for(size_t i = 0; i < parent_.size(); i++)
+            labels[i] = Find(i);
+        return labels;
+    }
+};
@@ -0,0 +1,115 @@
+// Throughput of a stream of `Unite()`/`IsSame()` events from many threads: `DisjointSets` behind a
+// mutex against `ConcurrentDisjointSets`.
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "disjoint_sets.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 20;
+constexpr int n_event = 1 << 22;
+
+// `x0 < 0` is `Unite(-x0, x1)`, otherwise `IsSame(x0, x1)`. Half of the events are unions.
+struct Event {
+    int x0, x1;
+};
+
+// One list of events per thread, `n_event` in total.
+vector<vector<Event>> Events(int n_thread) {
+    mt19937 gen(0);
+    vector<vector<Event>> events(n_thread);
+    for(int i = 0; i < n_event; i++) {
+        int x0 = gen() % n + 1, x1 = gen() % n + 1;
+        events[i % n_thread].push_back({gen() % 2 ? -x0 : x0, x1});
+    }
+    return events;
+}
+
+// Run `f(events[i])` on one thread per list, and wait.
+template<typename F>
+void RunThreads(const vector<vector<Event>> &events, F f) {
+    vector<thread> threads;
+    for(size_t i = 1; i < events.size(); i++)
+        threads.emplace_back([&, i] {
+            f(events[i]);
+        });
+    f(events[0]);
+    for(auto &thread: threads)
+        thread.join();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the thread count. Items are events.
+
+static void BM_DisjointSets_Mutex(benchmark::State &state) {
+    auto events = Events(state.range(0));
+    for(auto _: state) {
+        DisjointSets ds(n);
+        mutex m;
+        int same = 0;
+        RunThreads(events, [&](const vector<Event> &list) {
+            for(auto [x0, x1]: list) {
+                lock_guard<mutex> lock(m);
+                if(x0 < 0)
+                    ds.Unite(-x0, x1);
+                else
+                    same += ds.IsSame(x0, x1);
+            }
+        });
+        benchmark::DoNotOptimize(same);
+    }
+    state.SetItemsProcessed(state.iterations() * n_event);
+}
+BENCHMARK(BM_DisjointSets_Mutex)
+    ->DenseRange(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_ConcurrentDisjointSets(benchmark::State &state) {
+    auto events = Events(state.range(0));
+    for(auto _: state) {
+        ConcurrentDisjointSets ds(n);
+        atomic<int> same{0};
+        RunThreads(events, [&](const vector<Event> &list) {
+            int local_same = 0;
+            for(auto [x0, x1]: list) {
+                if(x0 < 0)
+                    ds.Unite(-x0, x1);
+                else
+                    local_same += ds.IsSame(x0, x1);
+            }
+            same += local_same;
+        });
+        benchmark::DoNotOptimize(same.load());
+    }
+    state.SetItemsProcessed(state.iterations() * n_event);
+}
+BENCHMARK(BM_ConcurrentDisjointSets)
+    ->DenseRange(1, thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine.
+
+Run on (1 X 2100 MHz CPU s)
+------------------------------------------------------------------------------------------------
+Benchmark                                      Time             CPU   Iterations UserCounters...
+------------------------------------------------------------------------------------------------
+BM_DisjointSets_Mutex/1/real_time            239 ms          237 ms            3 items_per_second=17.535M/s
+BM_ConcurrentDisjointSets/1/real_time        142 ms          141 ms            4 items_per_second=29.5485M/s
+
+*/
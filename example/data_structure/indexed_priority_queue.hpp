@@ -0,0 +1,127 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+// A mutable priority queue whose handles are integer keys in [0, n), e.g. node indexes.
+// Each key is in the queue at most once, so the heap never grows beyond n entries.
+// All storage is allocated in the constructor, so `push()` doesn't allocate.
+// Sifting moves a hole instead of swapping, and only keys are moved. Values stay in `values_`.
+template<class T, class Compare = std::less<T>>
+class indexed_priority_queue {
+    static constexpr size_t npos = -1;
+
+    std::vector<size_t> heap_;     // Keys in heap order.
+    std::vector<size_t> position_; // Position of each key in `heap_`, or `npos` if absent.
+    std::vector<T> values_;        // Value of each key.
+    Compare compare_;
+
+    inline size_t Parent(size_t k) {
+        return (k - 1) / 2;
+    }
+    void Up(size_t k) {
+        size_t key = heap_[k];
+        while(k) {
+            size_t parent = Parent(k);
+            if(!compare_(values_[heap_[parent]], values_[key]))
+                break;
+            heap_[k] = heap_[parent];
+            position_[heap_[k]] = k;
+            k = parent;
+        }
+        heap_[k] = key;
+        position_[key] = k;
+    }
+    void Down(size_t k) {
+        size_t key = heap_[k];
+        size_t size = heap_.size();
+        while(true) {
+            size_t child = k * 2 + 1;
+            if(child >= size)
+                break;
+            if(child + 1 < size && compare_(values_[heap_[child]], values_[heap_[child + 1]]))
+                child++;
+            if(!compare_(values_[key], values_[heap_[child]]))
+                break;
+            heap_[k] = heap_[child];
+            position_[heap_[k]] = k;
+            k = child;
+        }
+        heap_[k] = key;
+        position_[key] = k;
+    }
+
+public:
+    // Keys are in [0, n).
+    explicit indexed_priority_queue(size_t n, const Compare &compare = Compare())
+        : position_(n, npos), values_(n), compare_(compare) {
+        heap_.reserve(n);
+    }
+
+    // `key` must not be in the queue.
+    void push(size_t key, const T &value) {
+        values_[key] = value;
+        heap_.push_back(key);
+        Up(heap_.size() - 1);
+    }
+
+    // `key` must be in the queue.
+    void update(size_t key, const T &value) {
+        bool down = compare_(value, values_[key]);
+        values_[key] = value;
+        if(down)
+            Down(position_[key]);
+        else
+            Up(position_[key]);
+    }
+
+    // Return the key of the popped top.
+    size_t pop() {
+        size_t key = heap_.front();
+        position_[key] = npos;
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        if(!heap_.empty())
+            Down(0);
+        return key;
+    }
+
+    // `key` must be in the queue.
+    void erase(size_t key) {
+        size_t k = position_[key];
+        position_[key] = npos;
+        size_t last = heap_.back();
+        heap_.pop_back();
+        if(k == heap_.size())
+            return;
+        heap_[k] = last;
+        if(k && compare_(values_[heap_[Parent(k)]], values_[last]))
+            Up(k);
+        else
+            Down(k);
+    }
+
+    bool contains(size_t key) const {
+        return position_[key] != npos;
+    }
+
+    const T &top() const {
+        return values_[heap_.front()];
+    }
+
+    size_t top_key() const {
+        return heap_.front();
+    }
+
+    const T &get(size_t key) const {
+        return values_[key];
+    }
+
+    size_t size() const {
+        return heap_.size();
+    }
+
+    bool empty() const {
+        return heap_.empty();
+    }
+};
@@ -0,0 +1,110 @@
+// LOUDS (Level-Order Unary Degree Sequence) trie
+// An immutable, succinct trie, which can be saved to a file and memory-mapped back.
+
+#include <cassert>
+#include <cstdio>
+
+#include <filesystem>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "louds_trie.hpp"
+
+int main() {
+    Trie trie;
+    for(string s: {"abcd", "abxy", "ab", "bcd", "z"})
+        trie.Insert(s);
+    LoudsTrie louds(trie);
+
+    assert(louds.size() == 5);
+    assert(louds.Search("abcd") == true);
+    assert(louds.Search("ab") == true);
+    assert(louds.Search("z") == true);
+    assert(louds.Search("abc") == false);
+    assert(louds.Search("a") == false);
+    assert(louds.Search("abcde") == false);
+    assert(louds.Search("") == false);
+
+    assert(louds.StartsWith("abx") == true);
+    assert(louds.StartsWith("bc") == true);
+    assert(louds.StartsWith("") == true);
+    assert(louds.StartsWith("abz") == false);
+    assert(louds.StartsWith("y") == false);
+
+    assert(LoudsTrie().StartsWith("") == false);
+    assert(LoudsTrie(vector<string>{""}).Search("") == true);
+
+    // Random keys, any bytes or a small alphabet, against a set, before and after saving and
+    // loading, with enough keys for many blocks of the directory. The file is in the temporary
+    // directory, so a failed run leaves nothing behind in the source tree.
+    const string path = (filesystem::temp_directory_path() / "louds_trie.bin").string();
+    mt19937 gen(0);
+    for(int t = 0; t < 20; t++) {
+        int alphabet = t % 2 ? 3 : 256;
+        auto random_key = [&]() {
+            string key(gen() % 12, 0);
+            for(char &c: key)
+                c = char(gen() % alphabet);
+            return key;
+        };
+        set<string> keys;
+        for(int i = gen() % 20000; i > 0; i--)
+            keys.insert(random_key());
+        LoudsTrie built(vector<string>(keys.begin(), keys.end()));
+        assert(built.size() == keys.size());
+        assert(built.Save(path));
+
+        LoudsTrie loaded;
+        assert(loaded.Load(path));
+        assert(loaded.bytes() == built.bytes());
+        for(const LoudsTrie *louds: {&built, &loaded}) {
+            for(const string &key: keys)
+                assert(louds->Search(key));
+            for(int q = 0; q < 1000; q++) {
+                string key = random_key();
+                assert(louds->Search(key) == keys.count(key));
+                auto it = keys.lower_bound(key);
+                bool starts_with = it != keys.end() && it->compare(0, key.size(), key) == 0;
+                assert(louds->StartsWith(key) == starts_with);
+            }
+        }
+    }
+
+    // Truncated files, which must not be mapped as a trie whose arrays run past the end.
+    {
+        set<string> keys;
+        for(int i = 0; i < 100000; i++)
+            keys.insert(to_string(gen()));
+        LoudsTrie built(vector<string>(keys.begin(), keys.end()));
+        assert(built.Save(path));
+        FILE *file = fopen(path.c_str(), "rb");
+        vector<char> saved(built.bytes());
+        assert(fread(saved.data(), 1, saved.size(), file) == saved.size());
+        fclose(file);
+        for(size_t size: {size_t(64), size_t(8192), saved.size() - 8}) {
+            file = fopen(path.c_str(), "wb");
+            fwrite(saved.data(), 1, size, file);
+            fclose(file);
+            LoudsTrie louds(trie);
+            assert(!louds.Load(path));
+            assert(louds.size() == 5); // Unchanged.
+        }
+    }
+
+    // Not a file written by `Save()`.
+    {
+        FILE *file = fopen(path.c_str(), "wb");
+        fputs("not a trie, but long enough for a header", file);
+        fclose(file);
+        LoudsTrie louds(trie);
+        assert(!louds.Load(path));
+        assert(louds.Search("abcd")); // Unchanged.
+        assert(!louds.Load("no/such/file"));
+    }
+    remove(path.c_str());
+
+    return 0;
+}
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "trie.hpp"
+
+// An immutable trie on bytes in LOUDS (Level-Order Unary Degree Sequence) encoding, for
+// dictionaries that are built once and then only queried.
+// Nodes are numbered in breadth-first order from the root 0. Each node appends to `bits` one 1 per
+// child and then a 0, so node v's children are between the (v - 1)-th and v-th 0, and the i-th 1
+// overall is the edge to node i + 1, labeled `labels[i]`. So the edges of node v are
+// [select0(v - 1) + 1 - v, select0(v) - v). That's 2 bits, 1 bit for whether it ends a key and a
+// byte per node, and `select0()` takes a directory of 4 bytes per 64 bits and per 64 0s.
+// Everything is in one buffer laid out exactly like the file, so `Load()` maps the file and only
+// sets pointers into it: no parsing, and processes that load the same file share its pages.
+// The file is in the byte order of the machine that saved it.
+class LoudsTrie {
+    static constexpr uint64_t magic = 0x4549525444554f4c; // "LOUDTRIE" in little endian.
+    static constexpr size_t sample_zeros = 64;
+
+    // The header at the start of the buffer, followed by the arrays, each padded to 8 bytes.
+    struct Header {
+        uint64_t magic;
+        uint64_t nodes;
+        uint64_t keys;
+        uint64_t words; // Of `bits_`, which has `nodes * 2 - 1` bits, and 1s after them.
+        uint64_t samples; // Of `samples_`.
+    };
+
+    std::vector<uint64_t> storage_; // The buffer if built, empty if mapped.
+    const void *mapped_ = nullptr;
+    size_t mapped_size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE, mapping_ = nullptr;
+#endif
+
+    const Header *header_ = nullptr;
+    const uint64_t *bits_ = nullptr;
+    const uint64_t *words_ = nullptr; // Whether each node is the end of a key.
+    const uint32_t *zeros_ = nullptr; // 0s before each word of `bits_`, and in all of them.
+    const uint32_t *samples_ = nullptr; // The word of every `sample_zeros`-th 0.
+    const uint8_t *labels_ = nullptr;
+
+    static size_t Words(size_t bytes) {
+        return (bytes + 7) / 8;
+    }
+    static int PopCount(uint64_t x) {
+#ifdef _MSC_VER
+        return int(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+    static int CountTrailingZeros(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return i;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+    // Position of the `r`-th 1 of `x`, 0-based.
+    static int SelectInWord(uint64_t x, int r) {
+#ifdef __BMI2__
+        return CountTrailingZeros(_pdep_u64(uint64_t(1) << r, x));
+#else
+        for(; r > 0; r--)
+            x &= x - 1;
+        return CountTrailingZeros(x);
+#endif
+    }
+    // Position of the `k`-th 0 of `bits_`, 0-based.
+    size_t Select0(size_t k) const {
+        size_t w = samples_[k / sample_zeros];
+        while(zeros_[w + 1] <= k)
+            w++;
+        return w * 64 + SelectInWord(~bits_[w], k - zeros_[w]);
+    }
+    // Position of the first 0 of `bits_` at or after `i`.
+    size_t NextZero(size_t i) const {
+        size_t w = i / 64;
+        uint64_t x = ~bits_[w] >> (i % 64) << (i % 64);
+        while(!x)
+            x = ~bits_[++w];
+        return w * 64 + CountTrailingZeros(x);
+    }
+    // Words of the buffer described by `header`: the header, `bits_`, `words_`, `zeros_`,
+    // `samples_`, and a label per node but the root.
+    static size_t BufferWords(const Header &header) {
+        return Words(sizeof(Header)) + header.words + (header.nodes + 63) / 64
+               + Words((header.words + 1) * 4) + Words(header.samples * 4)
+               + Words(header.nodes - 1);
+    }
+    // Whether a buffer of `size` bytes starting with `header` is laid out like `Build()` does,
+    // so that `Attach()` only points into it.
+    static bool IsValid(const Header &header, size_t size) {
+        return header.magic == magic && header.nodes > 0 && header.nodes <= size
+               && header.keys <= header.nodes && header.words == (2 * header.nodes - 1 + 63) / 64
+               && header.samples == (header.nodes + sample_zeros - 1) / sample_zeros
+               && size == BufferWords(header) * sizeof(uint64_t);
+    }
+    // Set the pointers into a buffer laid out like the file.
+    void Attach(const void *data) {
+        header_ = static_cast<const Header *>(data);
+        const uint64_t *p = reinterpret_cast<const uint64_t *>(header_ + 1);
+        bits_ = p;
+        p += header_->words;
+        words_ = p;
+        p += (header_->nodes + 63) / 64;
+        zeros_ = reinterpret_cast<const uint32_t *>(p);
+        p += Words((header_->words + 1) * 4);
+        samples_ = reinterpret_cast<const uint32_t *>(p);
+        p += Words(header_->samples * 4);
+        labels_ = reinterpret_cast<const uint8_t *>(p);
+    }
+    void Unmap() {
+        if(!mapped_)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(mapped_);
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+        mapping_ = nullptr;
+#else
+        munmap(const_cast<void *>(mapped_), mapped_size_);
+#endif
+        mapped_ = nullptr;
+        mapped_size_ = 0;
+    }
+    // Lay out the buffer from the level-order encoding.
+    void Build(const std::vector<bool> &bits, const std::vector<bool> &words,
+               const std::vector<uint8_t> &labels, size_t keys) {
+        Header header{};
+        header.magic = magic;
+        header.nodes = words.size();
+        header.keys = keys;
+        header.words = (bits.size() + 63) / 64;
+        size_t zeros = header.nodes;
+        header.samples = (zeros + sample_zeros - 1) / sample_zeros;
+
+        size_t word_words = (header.nodes + 63) / 64;
+        storage_.assign(BufferWords(header), 0);
+        std::memcpy(storage_.data(), &header, sizeof(header));
+        uint64_t *p = storage_.data() + Words(sizeof(Header));
+        uint64_t *bits_words = p;
+        for(size_t w = 0; w < header.words; w++)
+            p[w] = ~uint64_t(0);
+        for(size_t i = 0; i < bits.size(); i++)
+            if(!bits[i])
+                p[i / 64] &= ~(uint64_t(1) << (i % 64));
+        p += header.words;
+        for(size_t v = 0; v < words.size(); v++)
+            if(words[v])
+                p[v / 64] |= uint64_t(1) << (v % 64);
+        p += word_words;
+        uint32_t *zeros_before = reinterpret_cast<uint32_t *>(p);
+        uint32_t *samples = reinterpret_cast<uint32_t *>(p + Words((header.words + 1) * 4));
+        size_t count = 0;
+        for(size_t w = 0; w < header.words; w++) {
+            zeros_before[w] = count;
+            size_t z = PopCount(~bits_words[w]);
+            // The words whose 0s include multiples of `sample_zeros`.
+            size_t s = (count + sample_zeros - 1) / sample_zeros;
+            for(; s * sample_zeros < count + z; s++)
+                samples[s] = w;
+            count += z;
+        }
+        zeros_before[header.words] = count;
+        p += Words((header.words + 1) * 4) + Words(header.samples * 4);
+        if(!labels.empty())
+            std::memcpy(p, labels.data(), labels.size());
+        Attach(storage_.data());
+    }
+
+public:
+    LoudsTrie() {
+        Build({false}, {false}, {}, 0); // Only the root.
+    }
+
+    // From keys in lexicographic order of unsigned bytes, e.g. from a `std::set<std::string>`, or
+    // `CompactTrie::ForEachWithPrefix("")`. Duplicates are fine.
+    LoudsTrie(const std::vector<std::string> &sorted_keys) {
+        std::vector<bool> bits, words;
+        std::vector<uint8_t> labels;
+        size_t keys = 0;
+        // Nodes in level order, as ranges of the keys below them, which share `depth` bytes.
+        struct Range {
+            size_t begin, end, depth;
+        };
+        std::deque<Range> queue{{0, sorted_keys.size(), 0}};
+        while(!queue.empty()) {
+            auto [begin, end, depth] = queue.front();
+            queue.pop_front();
+            bool word = false;
+            for(; begin < end && sorted_keys[begin].size() == depth; begin++)
+                word = true;
+            words.push_back(word);
+            keys += word;
+            while(begin < end) {
+                uint8_t byte = sorted_keys[begin][depth];
+                size_t next = begin + 1;
+                while(next < end && uint8_t(sorted_keys[next][depth]) == byte)
+                    next++;
+                bits.push_back(true);
+                labels.push_back(byte);
+                queue.push_back({begin, next, depth + 1});
+                begin = next;
+            }
+            bits.push_back(false);
+        }
+        Build(bits, words, labels, keys);
+    }
+
+    // From a `Trie`, walking its nodes in level order.
+    LoudsTrie(const Trie &trie) {
+        std::vector<bool> bits, words;
+        std::vector<uint8_t> labels;
+        size_t keys = 0;
+        std::deque<const Trie::TrieNode *> queue{&trie.root_};
+        while(!queue.empty()) {
+            const Trie::TrieNode *node = queue.front();
+            queue.pop_front();
+            words.push_back(node->is_word);
+            keys += node->is_word;
+            for(size_t k = 0; k < Trie::TrieNode::max_size; k++)
+                if(node->next[k]) {
+                    bits.push_back(true);
+                    labels.push_back('a' + k);
+                    queue.push_back(node->next[k].get());
+                }
+            bits.push_back(false);
+        }
+        Build(bits, words, labels, keys);
+    }
+
+    LoudsTrie(const LoudsTrie &) = delete;
+    LoudsTrie &operator=(const LoudsTrie &) = delete;
+
+    ~LoudsTrie() {
+        Unmap();
+    }
+
+    // Returns if the word is in the trie.
+    bool Search(std::string_view s) const {
+        size_t v = 0;
+        for(char c: s)
+            if(!Child(v, uint8_t(c), v))
+                return false;
+        return (words_[v / 64] >> (v % 64)) & 1;
+    }
+
+    // Returns if there is any word in the trie that starts with the given prefix.
+    bool StartsWith(std::string_view s) const {
+        size_t v = 0;
+        for(char c: s)
+            if(!Child(v, uint8_t(c), v))
+                return false;
+        return v != 0 || header_->keys > 0;
+    }
+
+    // The child of node `v` by `byte`, if any. Labels of siblings are sorted.
+    // Only the start of the edges takes a `Select0()`, the end is the next 0, usually in the same
+    // word.
+    bool Child(size_t v, uint8_t byte, size_t &child) const {
+        size_t start = v ? Select0(v - 1) + 1 : 0;
+        const uint8_t *first = labels_ + (start - v);
+        const uint8_t *last = labels_ + (NextZero(start) - v);
+        const uint8_t *it = std::lower_bound(first, last, byte);
+        if(it == last || *it != byte)
+            return false;
+        child = it - labels_ + 1;
+        return true;
+    }
+
+    // Write the buffer to `path`. Returns if it succeeded.
+    bool Save(const std::string &path) const {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if(!file)
+            return false;
+        size_t size = bytes();
+        bool ok = std::fwrite(header_, 1, size, file) == size;
+        return std::fclose(file) == 0 && ok;
+    }
+
+    // Map a file written by `Save()`. Returns if it succeeded, and leaves the trie as is if not,
+    // e.g. if the file is truncated or its header doesn't match its size.
+    bool Load(const std::string &path) {
+        const void *data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        HANDLE mapping = nullptr;
+        if(GetFileSizeEx(file, &file_size) && file_size.QuadPart >= LONGLONG(sizeof(Header)))
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping)
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(!data) {
+            if(mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        size = size_t(file_size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        if(fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Header)) {
+            size = st.st_size;
+            data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if(data == MAP_FAILED)
+                data = nullptr;
+        }
+        close(fd); // The mapping stays valid.
+        if(!data)
+            return false;
+#endif
+        // Checked before anything is read through the header, as a truncated file would make
+        // queries read past the end of the mapping.
+        if(!IsValid(*static_cast<const Header *>(data), size)) {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+            CloseHandle(file);
+#else
+            munmap(const_cast<void *>(data), size);
+#endif
+            return false;
+        }
+        Unmap();
+        storage_.clear();
+        storage_.shrink_to_fit();
+        mapped_ = data;
+        mapped_size_ = size;
+#ifdef _WIN32
+        file_ = file;
+        mapping_ = mapping;
+#endif
+        Attach(data);
+        return true;
+    }
+
+    // Number of keys.
+    size_t size() const {
+        return header_->keys;
+    }
+
+    // Bytes of the buffer, which is also the size of the file.
+    size_t bytes() const {
+        return mapped_ ? mapped_size_ : storage_.size() * sizeof(uint64_t);
+    }
+};
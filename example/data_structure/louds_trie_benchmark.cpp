@@ -0,0 +1,192 @@
+// `LoudsTrie` on URL-like keys: build time, file size, time to load the file, and `Search` and
+// `StartsWith` latency against `Trie` and `CompactTrie`.
+
+#include <cstdio>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "louds_trie.hpp"
+#include "trie_keys.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+vector<string> Sorted(vector<string> keys) {
+    sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Half of `keys`, and half of `Misses()`.
+vector<string> Queries(const vector<string> &keys) {
+    vector<string> misses = Misses(keys), queries;
+    for(size_t i = 0; i < keys.size(); i++)
+        queries.push_back(i % 2 ? misses[i] : keys[i]);
+    return queries;
+}
+
+// The host part of the keys, which are prefixes of many keys.
+vector<string> Prefixes(const vector<string> &keys) {
+    vector<string> prefixes;
+    for(const string &key: keys)
+        prefixes.push_back(key.substr(0, key.find("com") + 3));
+    return prefixes;
+}
+
+// In the temporary directory, so an aborted run leaves nothing behind in the source tree.
+const string path = (filesystem::temp_directory_path() / "louds_trie_benchmark.bin").string();
+
+/*------------------------------------------------------------------------------------------------*/
+// Build from `state.range(0)` sorted keys or from a `Trie`, and save and load. Items are keys.
+
+static void BM_LoudsTrie_Build(benchmark::State &state) {
+    vector<string> keys = Sorted(Keys(state.range(0)));
+    size_t bytes = 0;
+    for(auto _: state) {
+        LoudsTrie louds(keys);
+        bytes = louds.bytes();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    state.counters["file_bytes_per_key"] = double(bytes) / keys.size();
+}
+BENCHMARK(BM_LoudsTrie_Build)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_LoudsTrie_BuildFromTrie(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    Trie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    for(auto _: state)
+        LoudsTrie louds(trie);
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_LoudsTrie_BuildFromTrie)->RangeMultiplier(16)->Range(1 << 12, 1 << 16);
+
+static void BM_LoudsTrie_Save(benchmark::State &state) {
+    LoudsTrie louds(Sorted(Keys(state.range(0))));
+    for(auto _: state)
+        benchmark::DoNotOptimize(louds.Save(path));
+    state.SetBytesProcessed(state.iterations() * louds.bytes());
+}
+BENCHMARK(BM_LoudsTrie_Save)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+// Only maps the file: the pages are read when the queries touch them.
+static void BM_LoudsTrie_Load(benchmark::State &state) {
+    LoudsTrie(Sorted(Keys(state.range(0)))).Save(path);
+    for(auto _: state) {
+        LoudsTrie louds;
+        benchmark::DoNotOptimize(louds.Load(path));
+    }
+    remove(path.c_str());
+}
+BENCHMARK(BM_LoudsTrie_Load)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` keys, queried in random order. Items are queries.
+
+template<class TrieType>
+static void Search(benchmark::State &state, const TrieType &trie, const vector<string> &queries) {
+    for(auto _: state)
+        for(const string &query: queries)
+            benchmark::DoNotOptimize(trie.Search(query));
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+template<class TrieType>
+static void StartsWith(benchmark::State &state, const TrieType &trie,
+                       const vector<string> &prefixes) {
+    for(auto _: state)
+        for(const string &prefix: prefixes)
+            benchmark::DoNotOptimize(trie.StartsWith(prefix));
+    state.SetItemsProcessed(state.iterations() * prefixes.size());
+}
+
+static void BM_Trie_Search(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    Trie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    // `Trie::Search()` isn't `const`.
+    vector<string> queries = Queries(keys);
+    for(auto _: state)
+        for(const string &query: queries)
+            benchmark::DoNotOptimize(trie.Search(query));
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Trie_Search)->RangeMultiplier(16)->Range(1 << 12, 1 << 16);
+
+static void BM_CompactTrie_Search(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    CompactTrie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    trie.Compact();
+    Search(state, trie, Queries(keys));
+}
+BENCHMARK(BM_CompactTrie_Search)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_LoudsTrie_Search(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    Search(state, LoudsTrie(Sorted(keys)), Queries(keys));
+}
+BENCHMARK(BM_LoudsTrie_Search)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_CompactTrie_StartsWith(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    CompactTrie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    trie.Compact();
+    StartsWith(state, trie, Prefixes(keys));
+}
+BENCHMARK(BM_CompactTrie_StartsWith)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_LoudsTrie_StartsWith(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    StartsWith(state, LoudsTrie(Sorted(keys)), Prefixes(keys));
+}
+BENCHMARK(BM_LoudsTrie_StartsWith)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------------
+Benchmark                                  Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------------
+BM_LoudsTrie_Build/4096              2003591 ns      1978922 ns          342 file_bytes_per_key=22.2891 items_per_second=2.06981M/s
+BM_LoudsTrie_Build/65536            51632367 ns     49889650 ns           14 file_bytes_per_key=22.5396 items_per_second=1.31362M/s
+BM_LoudsTrie_Build/1048576        2144812915 ns   2119447799 ns            1 file_bytes_per_key=22.7427 items_per_second=494.74k/s
+BM_LoudsTrie_BuildFromTrie/4096      6268971 ns      6041563 ns          115 items_per_second=677.97k/s
+BM_LoudsTrie_BuildFromTrie/65536   213264124 ns    210034374 ns            4 items_per_second=312.025k/s
+BM_LoudsTrie_Save/4096                200311 ns        73009 ns         9768 bytes_per_second=1.1646G/s
+BM_LoudsTrie_Save/65536              1555874 ns       417069 ns         1622 bytes_per_second=3.29851G/s
+BM_LoudsTrie_Save/1048576           30978404 ns      9389251 ns           68 bytes_per_second=2.36543G/s
+BM_LoudsTrie_Load/4096                 13712 ns        13444 ns        54487
+BM_LoudsTrie_Load/65536                14400 ns        12811 ns        55737
+BM_LoudsTrie_Load/1048576              12485 ns        12305 ns        56782
+BM_Trie_Search/4096                  2196723 ns      2164065 ns          324 items_per_second=1.89273M/s
+BM_Trie_Search/65536               134980116 ns    131711056 ns            6 items_per_second=497.574k/s
+BM_CompactTrie_Search/4096            814903 ns       807318 ns          867 items_per_second=5.07359M/s
+BM_CompactTrie_Search/65536         22693531 ns     22276051 ns           31 items_per_second=2.94199M/s
+BM_CompactTrie_Search/1048576     1146579552 ns   1115200506 ns            1 items_per_second=940.258k/s
+BM_LoudsTrie_Search/4096             3267132 ns      3183367 ns          243 items_per_second=1.28669M/s
+BM_LoudsTrie_Search/65536           72311531 ns     71070495 ns            9 items_per_second=922.127k/s
+BM_LoudsTrie_Search/1048576       4276511944 ns   4121439900 ns            1 items_per_second=254.42k/s
+BM_CompactTrie_StartsWith/4096        362232 ns       340410 ns         2007 items_per_second=12.0326M/s
+BM_CompactTrie_StartsWith/65536      9987510 ns      9648490 ns           78 items_per_second=6.79236M/s
+BM_CompactTrie_StartsWith/1048576  242813011 ns    239996834 ns            3 items_per_second=4.36912M/s
+BM_LoudsTrie_StartsWith/4096         1414069 ns      1377396 ns          511 items_per_second=2.97373M/s
+BM_LoudsTrie_StartsWith/65536       30490528 ns     30253160 ns           23 items_per_second=2.16625M/s
+BM_LoudsTrie_StartsWith/1048576    823615511 ns    782235557 ns            1 items_per_second=1.34049M/s
+*/
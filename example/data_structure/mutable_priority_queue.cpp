@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cstdint>
 #include <ctime>
 
 #include <algorithm>
@@ -9,126 +10,10 @@
 #include <set>
 #include <vector>
 
-template<class T,
-         class Container = std::vector<T>,
-         class Compare = std::less<typename Container::value_type>>
-class priority_queue {
-    inline size_t Left(size_t k) {
-        size_t left = k * 2 + 1;
-        if(left < container_.size())
-            return left;
-        return k;
-    }
-    inline size_t Right(size_t k) {
-        size_t right = k * 2 + 2;
-        if(right < container_.size())
-            return right;
-        return k;
-    }
-    inline size_t Parent(size_t k) {
-        return (k - 1) / 2;
-    }
-    void Up(size_t k) {
-        size_t parent = Parent(k);
-
-        while(k && compare_(container_[parent], container_[k])) {
-            std::swap(container_[k], container_[parent]);
-            std::swap(*handles_[k].value_id_, *handles_[parent].value_id_);
-            std::swap(handles_[k].value_id_, handles_[parent].value_id_);
-            k = parent;
-            parent = Parent(k);
-        }
-    }
-    void Down(size_t k) {
-        if(container_.size() == 0)
-            return;
-
-        size_t left = Left(k);
-        size_t right = Right(k);
-
-        while(compare_(container_[k], container_[left])
-              || compare_(container_[k], container_[right])) {
-            if(compare_(container_[right], container_[left])) {
-                std::swap(container_[k], container_[left]);
-                std::swap(*handles_[k].value_id_, *handles_[left].value_id_);
-                std::swap(handles_[k].value_id_, handles_[left].value_id_);
-                k = left;
-            } else {
-                std::swap(container_[k], container_[right]);
-                std::swap(*handles_[k].value_id_, *handles_[right].value_id_);
-                std::swap(handles_[k].value_id_, handles_[right].value_id_);
-                k = right;
-            }
-            left = Left(k);
-            right = Right(k);
-        }
-    }
-
-public:
-    class handle_type {
-        std::shared_ptr<size_t> value_id_;
-
-        handle_type(size_t value_id): value_id_(std::make_shared<size_t>(value_id)) {}
-
-        friend class priority_queue;
-    };
-
-protected:
-    Container container_;
-    Compare compare_;
-    std::vector<handle_type> handles_;
-
-public:
-    priority_queue(const Compare &compare = Compare()): compare_(compare) {}
-
-    handle_type push(const T &value) {
-        handles_.push_back(container_.size());
-        handle_type handle = handles_.back();
-        container_.push_back(value);
-        Up(container_.size() - 1);
-        return handle;
-    }
-
-    handle_type push(T &&value) {
-        handles_.push_back(container_.size());
-        handle_type handle = handles_.back();
-        container_.push_back(value);
-        Up(container_.size() - 1);
-        return handle;
-    }
-
-    void pop() {
-        container_.front() = container_.back();
-        container_.pop_back();
-        // 2 interesting assignments without using `swap()`!
-        *handles_.back().value_id_ = *handles_.front().value_id_;
-        handles_.front().value_id_ = handles_.back().value_id_;
-        handles_.pop_back();
-        Down(0);
-    }
-
-    void update(const handle_type &handle, const T &value) {
-        size_t value_id = *handle.value_id_;
-        bool down = compare_(value, container_[value_id]);
-        container_[value_id] = value;
-        if(down)
-            Down(value_id);
-        else
-            Up(value_id);
-    }
-
-    const T &top() const {
-        return container_.front();
-    }
-
-    const T &get(const handle_type &handle) const {
-        return container_[*handle.value_id_];
-    }
-
-    size_t size() const {
-        return container_.size();
-    }
-};
+#include "indexed_priority_queue.hpp"
+#include "mutable_priority_queue.hpp"
+#include "pairing_heap.hpp"
+#include "radix_heap.hpp"
 
 int main() {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
@@ -211,4 +96,168 @@ int main() {
             std_set.erase(std_set.begin());
         }
     }
+
+    // `indexed_priority_queue` with random values and indexes as keys. Top is min.
+    for(int i = 0; i < k; i++) {
+        int n = std::rand() % 10000;
+
+        std::vector<int> v(n);
+        for(int i = 0; i < n; i++)
+            v[i] = std::rand() % n;
+
+        indexed_priority_queue<int, std::greater<int>> pq(n);
+        std::set<std::pair<int, int>> std_set;
+
+        // Push half of the keys, then push or update all of them.
+        for(int i = 0; i < n; i += 2) {
+            assert(!pq.contains(i));
+            pq.push(i, v[i]);
+            assert(pq.contains(i) && pq.get(i) == v[i]);
+            std_set.insert({v[i], i});
+            assert(pq.top() == std_set.begin()->first);
+        }
+
+        for(int i = 0; i < n; i++) {
+            if(pq.contains(i))
+                std_set.erase({v[i], i});
+            v[i] = std::rand() % n;
+            if(pq.contains(i))
+                pq.update(i, v[i]);
+            else
+                pq.push(i, v[i]);
+            std_set.insert({v[i], i});
+            assert(pq.get(i) == v[i]);
+            assert(pq.top() == std_set.begin()->first);
+        }
+        assert(pq.size() == std_set.size());
+
+        // Erase a quarter of the keys.
+        for(int i = 0; i < n; i += 4) {
+            pq.erase(i);
+            assert(!pq.contains(i));
+            std_set.erase({v[i], i});
+            if(!pq.empty())
+                assert(pq.top() == std_set.begin()->first);
+        }
+        assert(pq.size() == std_set.size());
+
+        while(!pq.empty()) {
+            int key = pq.top_key();
+            assert(pq.get(key) == pq.top());
+            assert(pq.top() == std_set.begin()->first);
+            std_set.erase({v[key], key});
+            assert(pq.pop() == size_t(key));
+            assert(!pq.contains(key));
+        }
+        assert(std_set.empty());
+    }
+
+    // `pairing_heap` with random pairs with `second` as unique indexes, top is max or min.
+    auto test_pairing_heap = [&](auto pq, auto std_set) {
+        int n = std::rand() % 10000;
+
+        std::vector<value_type> v(n);
+        for(int i = 0; i < n; i++)
+            v[i] = {std::rand() % n, i};
+
+        std::vector<typename decltype(pq)::handle_type> handles;
+        for(int i = 0; i < n; i++) {
+            handles.push_back(pq.push(v[i]));
+            assert(pq.get(handles[i]) == v[i]);
+            std_set.insert(v[i]);
+            assert(pq.top() == *std_set.begin());
+        }
+
+        for(int i = 0; i < n; i++) {
+            std_set.erase(std_set.find(v[i]));
+            v[i].first = std::rand() % n;
+            pq.update(handles[i], v[i]);
+            std_set.insert(v[i]);
+            assert(pq.get(handles[i]) == v[i]);
+            assert(pq.top() == *std_set.begin());
+        }
+
+        // Erase a quarter of the values, then push them again.
+        for(int i = 0; i < n; i += 4) {
+            pq.erase(handles[i]);
+            std_set.erase(v[i]);
+            assert(pq.size() == std_set.size());
+            if(!pq.empty())
+                assert(pq.top() == *std_set.begin());
+        }
+        for(int i = 0; i < n; i += 4) {
+            handles[i] = pq.push(v[i]);
+            std_set.insert(v[i]);
+            assert(pq.top() == *std_set.begin());
+        }
+
+        for(int i = 0; i < n; i++) {
+            value_type value = pq.top();
+            assert(pq.top_handle() == handles[value.second]);
+            assert(pq.top() == *std_set.begin());
+            pq.pop();
+            std_set.erase(std_set.begin());
+        }
+        assert(pq.empty());
+    };
+    for(int i = 0; i < k; i++) {
+        test_pairing_heap(pairing_heap<value_type>(),
+                          std::set<value_type, std::greater<value_type>>());
+        test_pairing_heap(pairing_heap<value_type, std::greater<value_type>>(),
+                          std::set<value_type>());
+    }
+
+    // `radix_heap` with random monotone pushes, updates, erases and pops. Top is min.
+    for(int i = 0; i < k; i++) {
+        int n = std::rand() % 10000;
+        uint64_t range = i % 2 ? 10 : 1u << 31; // Many equal keys, or few.
+
+        radix_heap<uint64_t> pq;
+        std::set<std::pair<uint64_t, size_t>> std_set;
+        std::vector<size_t> handles;
+        uint64_t last = 0;
+        for(int op = 0; op < n * 3; op++) {
+            switch(std::rand() % 4) {
+            case 0:
+            case 1: {
+                uint64_t key = last + std::rand() % range;
+                size_t handle = pq.push(key);
+                assert(pq.get(handle) == key);
+                std_set.insert({key, handle});
+                handles.push_back(handle);
+                break;
+            }
+            case 2: {
+                if(handles.empty())
+                    break;
+                size_t j = std::rand() % handles.size();
+                size_t handle = handles[j];
+                std_set.erase({pq.get(handle), handle});
+                if(std::rand() % 2) {
+                    uint64_t key = last + std::rand() % range;
+                    pq.update(handle, key);
+                    std_set.insert({key, handle});
+                } else {
+                    pq.erase(handle);
+                    handles[j] = handles.back();
+                    handles.pop_back();
+                }
+                break;
+            }
+            case 3: {
+                if(pq.empty())
+                    break;
+                last = pq.top();
+                assert(last == std_set.begin()->first);
+                size_t handle = pq.top_handle();
+                assert(pq.get(handle) == last && std_set.count({last, handle}));
+                std_set.erase({last, handle});
+                handles.erase(std::find(handles.begin(), handles.end(), handle));
+                pq.pop();
+                break;
+            }
+            }
+            assert(pq.size() == std_set.size());
+        }
+    }
 }
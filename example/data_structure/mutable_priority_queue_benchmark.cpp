@@ -0,0 +1,230 @@
+// Mutable priority queues: `priority_queue`, whose handles are shared pointers,
+// `indexed_priority_queue`, whose handles are integer keys, and the node pool backed `pairing_heap`
+// and `radix_heap`.
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "indexed_priority_queue.hpp"
+#include "mutable_priority_queue.hpp"
+#include "pairing_heap.hpp"
+#include "radix_heap.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+// `n` random values, then `n` random new values.
+vector<int> Values(int n) {
+    mt19937 gen(0);
+    vector<int> values(n * 2);
+    for(int &value: values)
+        value = gen() % n;
+    return values;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Push `state.range(0)` values, update each of them once, then pop them all. Items are operations.
+
+static void BM_PriorityQueue(benchmark::State &state) {
+    int n = state.range(0);
+    auto values = Values(n);
+    for(auto _: state) {
+        ::priority_queue<int> pq;
+        vector<decltype(pq)::handle_type> handles;
+        handles.reserve(n);
+        for(int i = 0; i < n; i++)
+            handles.push_back(pq.push(values[i]));
+        for(int i = 0; i < n; i++)
+            pq.update(handles[i], values[n + i]);
+        while(pq.size()) {
+            benchmark::DoNotOptimize(pq.top());
+            pq.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n * 3);
+}
+BENCHMARK(BM_PriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_IndexedPriorityQueue(benchmark::State &state) {
+    int n = state.range(0);
+    auto values = Values(n);
+    for(auto _: state) {
+        indexed_priority_queue<int> pq(n);
+        for(int i = 0; i < n; i++)
+            pq.push(i, values[i]);
+        for(int i = 0; i < n; i++)
+            pq.update(i, values[n + i]);
+        while(!pq.empty())
+            benchmark::DoNotOptimize(pq.pop());
+    }
+    state.SetItemsProcessed(state.iterations() * n * 3);
+}
+BENCHMARK(BM_IndexedPriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+static void BM_PairingHeap(benchmark::State &state) {
+    int n = state.range(0);
+    auto values = Values(n);
+    for(auto _: state) {
+        pairing_heap<int> pq;
+        vector<decltype(pq)::handle_type> handles;
+        handles.reserve(n);
+        for(int i = 0; i < n; i++)
+            handles.push_back(pq.push(values[i]));
+        for(int i = 0; i < n; i++)
+            pq.update(handles[i], values[n + i]);
+        while(!pq.empty()) {
+            benchmark::DoNotOptimize(pq.top());
+            pq.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n * 3);
+}
+BENCHMARK(BM_PairingHeap)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+// Top is min, unlike the others, with the same number of comparisons.
+static void BM_RadixHeap(benchmark::State &state) {
+    int n = state.range(0);
+    auto values = Values(n);
+    for(auto _: state) {
+        radix_heap<uint32_t> pq;
+        vector<decltype(pq)::handle_type> handles;
+        handles.reserve(n);
+        for(int i = 0; i < n; i++)
+            handles.push_back(pq.push(values[i]));
+        for(int i = 0; i < n; i++)
+            pq.update(handles[i], values[n + i]);
+        while(!pq.empty()) {
+            benchmark::DoNotOptimize(pq.top());
+            pq.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n * 3);
+}
+BENCHMARK(BM_RadixHeap)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// Decrease-key heavy: push `state.range(0)` values, move a random one towards the top 4 times per
+// value, then pop them all. Top is min. Items are operations.
+
+constexpr int n_decrease = 4;
+
+// `n` random values in [n * 4, n * 8), then `n * n_decrease` random indexes with decreases.
+struct DecreaseOps {
+    vector<int> values;
+    vector<pair<int, int>> decreases;
+};
+
+DecreaseOps Decreases(int n) {
+    mt19937 gen(0);
+    DecreaseOps ops;
+    ops.values.resize(n);
+    for(int &value: ops.values)
+        value = n * 4 + gen() % (n * 4);
+    ops.decreases.resize(n * n_decrease);
+    for(auto &[i, d]: ops.decreases) {
+        i = gen() % n;
+        d = gen() % 8 + 1;
+    }
+    return ops;
+}
+
+template<class Queue>
+static void BM_Decrease(benchmark::State &state) {
+    int n = state.range(0);
+    auto ops = Decreases(n);
+    for(auto _: state) {
+        Queue pq;
+        vector<typename Queue::handle_type> handles;
+        handles.reserve(n);
+        vector<int> values = ops.values;
+        for(int i = 0; i < n; i++)
+            handles.push_back(pq.push(values[i]));
+        for(auto [i, d]: ops.decreases) {
+            values[i] -= d;
+            pq.update(handles[i], values[i]);
+        }
+        while(!pq.empty()) {
+            benchmark::DoNotOptimize(pq.top());
+            pq.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n * (n_decrease + 2));
+}
+
+static void BM_Decrease_IndexedPriorityQueue(benchmark::State &state) {
+    int n = state.range(0);
+    auto ops = Decreases(n);
+    for(auto _: state) {
+        indexed_priority_queue<int, greater<int>> pq(n);
+        vector<int> values = ops.values;
+        for(int i = 0; i < n; i++)
+            pq.push(i, values[i]);
+        for(auto [i, d]: ops.decreases) {
+            values[i] -= d;
+            pq.update(i, values[i]);
+        }
+        while(!pq.empty())
+            benchmark::DoNotOptimize(pq.pop());
+    }
+    state.SetItemsProcessed(state.iterations() * n * (n_decrease + 2));
+}
+
+// Like `pq.empty()` for `priority_queue`, which has no `empty()`.
+template<class T, class Container, class Compare>
+struct PriorityQueue: ::priority_queue<T, Container, Compare> {
+    bool empty() const {
+        return !this->size();
+    }
+};
+
+BENCHMARK_TEMPLATE(BM_Decrease, PriorityQueue<int, vector<int>, greater<int>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_Decrease_IndexedPriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Decrease, pairing_heap<int, greater<int>>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Decrease, radix_heap<uint32_t>)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+-----------------------------------------------------------------------------------------------------------------------------
+Benchmark                                                                   Time             CPU   Iterations UserCounters...
+-----------------------------------------------------------------------------------------------------------------------------
+BM_PriorityQueue/4096                                                  847378 ns       819124 ns          943 items_per_second=15.0014M/s
+BM_PriorityQueue/65536                                               22027514 ns     21855974 ns           36 items_per_second=8.99562M/s
+BM_PriorityQueue/1048576                                            678375670 ns    673530659 ns            1 items_per_second=4.6705M/s
+BM_IndexedPriorityQueue/4096                                           579222 ns       571209 ns         1330 items_per_second=21.5123M/s
+BM_IndexedPriorityQueue/65536                                        13661008 ns     13468161 ns           51 items_per_second=14.598M/s
+BM_IndexedPriorityQueue/1048576                                     548724163 ns    545688837 ns            1 items_per_second=5.76469M/s
+BM_PairingHeap/4096                                                    882576 ns       873944 ns          897 items_per_second=14.0604M/s
+BM_PairingHeap/65536                                                 24930475 ns     24685365 ns           30 items_per_second=7.96456M/s
+BM_PairingHeap/1048576                                             1230486216 ns   1219439676 ns            1 items_per_second=2.57965M/s
+BM_RadixHeap/4096                                                      384283 ns       379412 ns         1841 items_per_second=32.387M/s
+BM_RadixHeap/65536                                                    7121680 ns      7087023 ns           97 items_per_second=27.742M/s
+BM_RadixHeap/1048576                                                250485561 ns    246389351 ns            3 items_per_second=12.7673M/s
+BM_Decrease<PriorityQueue<int, vector<int>, greater<int>>>/4096        886125 ns       851555 ns          893 items_per_second=28.8601M/s
+BM_Decrease<PriorityQueue<int, vector<int>, greater<int>>>/65536     18152868 ns     17999911 ns           33 items_per_second=21.8454M/s
+BM_Decrease<PriorityQueue<int, vector<int>, greater<int>>>/1048576  775500587 ns    768214715 ns            1 items_per_second=8.18971M/s
+BM_Decrease_IndexedPriorityQueue/4096                                  616342 ns       608380 ns         1135 items_per_second=40.3958M/s
+BM_Decrease_IndexedPriorityQueue/65536                               16197315 ns     15942921 ns           42 items_per_second=24.664M/s
+BM_Decrease_IndexedPriorityQueue/1048576                            673616820 ns    666397101 ns            1 items_per_second=9.441M/s
+BM_Decrease<pairing_heap<int, greater<int>>>/4096                      941372 ns       926423 ns          873 items_per_second=26.5278M/s
+BM_Decrease<pairing_heap<int, greater<int>>>/65536                   26845986 ns     26625423 ns           26 items_per_second=14.7684M/s
+BM_Decrease<pairing_heap<int, greater<int>>>/1048576               1480935385 ns   1459198487 ns            1 items_per_second=4.31158M/s
+BM_Decrease<radix_heap<uint32_t>>/4096                                 584803 ns       576225 ns         1207 items_per_second=42.65M/s
+BM_Decrease<radix_heap<uint32_t>>/65536                              14306113 ns     14224538 ns           48 items_per_second=27.6435M/s
+BM_Decrease<radix_heap<uint32_t>>/1048576                           699292922 ns    683604026 ns            1 items_per_second=9.20336M/s
+*/
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// A mutable priority queue on a pairing heap. Top is max by `Compare`, like `priority_queue`.
+// `push()` and an `update()` towards the top are O(1) amortized, `pop()` is O(log n) amortized,
+// so it suits workloads that reprioritize much more often than they pop.
+// Nodes live in a pool and are linked by index. Popped nodes are reused by later pushes, so the
+// pool only allocates when the heap grows beyond its largest size so far.
+template<class T, class Compare = std::less<T>>
+class pairing_heap {
+public:
+    // Valid from `push()` until the value is popped or erased.
+    using handle_type = size_t;
+
+private:
+    // 32-bit links keep the nodes of small values within half a cache line.
+    using Index = uint32_t;
+    static constexpr Index npos = -1;
+
+    struct Node {
+        T value;
+        Index child; // Leftmost child.
+        Index next; // Right sibling.
+        Index prev; // Left sibling, or parent for the leftmost child.
+        Index parent;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<Index> free_; // Unused nodes in `nodes_`.
+    std::vector<Index> roots_; // Scratch for `Combine()`.
+    Index root_ = npos;
+    size_t size_ = 0;
+    Compare compare_;
+
+    // Link two roots, return the new root.
+    Index Meld(Index a, Index b) {
+        if(a == npos)
+            return b;
+        if(b == npos)
+            return a;
+        if(compare_(nodes_[a].value, nodes_[b].value))
+            std::swap(a, b);
+        // `b` becomes the leftmost child of `a`.
+        nodes_[b].prev = nodes_[b].parent = a;
+        nodes_[b].next = nodes_[a].child;
+        if(nodes_[a].child != npos)
+            nodes_[nodes_[a].child].prev = b;
+        nodes_[a].child = b;
+        return a;
+    }
+    // Combine the siblings from `first` into one tree by two-pass pairing, return its root.
+    Index Combine(Index first) {
+        roots_.clear();
+        while(first != npos) {
+            Index a = first, b = nodes_[a].next;
+            first = b == npos ? npos : nodes_[b].next;
+            nodes_[a].next = nodes_[a].prev = nodes_[a].parent = npos;
+            if(b != npos)
+                nodes_[b].next = nodes_[b].prev = nodes_[b].parent = npos;
+            roots_.push_back(Meld(a, b));
+        }
+        Index root = npos;
+        for(size_t i = roots_.size(); i-- > 0;)
+            root = Meld(roots_[i], root);
+        return root;
+    }
+    // Detach the subtree of `k`, which is not the root, from its parent and siblings.
+    void Cut(Index k) {
+        Node &node = nodes_[k];
+        if(nodes_[node.prev].child == k)
+            nodes_[node.prev].child = node.next;
+        else
+            nodes_[node.prev].next = node.next;
+        if(node.next != npos)
+            nodes_[node.next].prev = node.prev;
+        node.next = node.prev = node.parent = npos;
+    }
+    // Detach `k` alone, with its children melded back into the heap.
+    void Remove(Index k) {
+        if(k == root_) {
+            root_ = Combine(nodes_[k].child);
+        } else {
+            Cut(k);
+            root_ = Meld(root_, Combine(nodes_[k].child));
+        }
+        if(root_ != npos)
+            nodes_[root_].prev = npos;
+        nodes_[k].child = npos;
+    }
+
+public:
+    pairing_heap(const Compare &compare = Compare()): compare_(compare) {}
+
+    handle_type push(T value) {
+        Index k;
+        if(free_.empty()) {
+            k = nodes_.size();
+            nodes_.push_back({std::move(value), npos, npos, npos, npos});
+        } else {
+            k = free_.back();
+            free_.pop_back();
+            nodes_[k] = {std::move(value), npos, npos, npos, npos};
+        }
+        root_ = Meld(root_, k);
+        size_++;
+        return k;
+    }
+
+    void pop() {
+        erase(root_);
+    }
+
+    void erase(const handle_type &handle) {
+        Remove(handle);
+        free_.push_back(handle);
+        size_--;
+    }
+
+    void update(const handle_type &handle, const T &value) {
+        bool up = compare_(nodes_[handle].value, value);
+        nodes_[handle].value = value;
+        if(up) {
+            // Its subtree is still a heap, and only the link to its parent may be out of order.
+            // Small moves often leave it in order, and cutting anyway would pile up children on the
+            // root for `pop()` to pair.
+            Index parent = nodes_[handle].parent;
+            if(parent != npos && compare_(nodes_[parent].value, value)) {
+                Cut(handle);
+                root_ = Meld(root_, handle);
+            }
+        } else {
+            Remove(handle);
+            root_ = Meld(root_, handle);
+        }
+    }
+
+    const T &top() const {
+        return nodes_[root_].value;
+    }
+
+    handle_type top_handle() const {
+        return root_;
+    }
+
+    const T &get(const handle_type &handle) const {
+        return nodes_[handle].value;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+};
@@ -3,94 +3,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <queue>
 #include <vector>
 #include <numeric>
 #include <random>
 #include <set>
 
-template<class T,
-         class Container = std::vector<T>,
-         class Compare = std::less<typename Container::value_type>>
-class priority_queue {
-    inline size_t Left(size_t k) {
-        size_t left = k * 2 + 1;
-        if(left < container_.size())
-            return left;
-        return k;
-    }
-    inline size_t Right(size_t k) {
-        size_t right = k * 2 + 2;
-        if(right < container_.size())
-            return right;
-        return k;
-    }
-    inline size_t Parent(size_t k) {
-        return (k - 1) / 2;
-    }
-    void Up() {
-        size_t k = container_.size() - 1;
-        size_t parent = Parent(k);
-
-        while(k && compare_(container_[parent], container_[k])) {
-            std::swap(container_[k], container_[parent]);
-            k = parent;
-            parent = Parent(k);
-        }
-    }
-    void Down() {
-        if(container_.size() == 0)
-            return;
-
-        size_t k = 0;
-        size_t left = Left(k);
-        size_t right = Right(k);
-
-        while(compare_(container_[k], container_[left])
-              || compare_(container_[k], container_[right])) {
-            if(compare_(container_[right], container_[left])) {
-                std::swap(container_[k], container_[left]);
-                k = left;
-            } else {
-                std::swap(container_[k], container_[right]);
-                k = right;
-            }
-            left = Left(k);
-            right = Right(k);
-        }
-    }
-
-protected:
-    Container container_;
-    Compare compare_;
-
-public:
-    priority_queue(const Compare &compare = Compare()): compare_(compare) {}
-
-    void push(const T &value) {
-        container_.push_back(value);
-        Up();
-    }
-
-    void push(T &&value) {
-        container_.push_back(value);
-        Up();
-    }
-
-    void pop() {
-        container_.front() = container_.back();
-        container_.pop_back();
-        Down();
-    }
-
-    const T &top() const {
-        return container_.front();
-    }
-
-    size_t size() const {
-        return container_.size();
-    }
-};
+#include "priority_queue.hpp"
 
 int main() {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
@@ -199,4 +119,63 @@ int main() {
             std_set.erase(std_set.begin());
         }
     }
+
+    // d-ary heaps of several arities, with single and bulk pushes, against `std::priority_queue`.
+    auto test_d_ary_heap = [&](auto heap) {
+        std::mt19937 gen(0);
+        for(int i = 0; i < k; i++) {
+            int n = gen() % 1000;
+            std::vector<int> v(n);
+            for(int &x: v)
+                x = gen() % (i % 2 ? 10 : 1000000);
+            decltype(heap) pq(i % 3 ? std::vector<int>() : v);
+            std::priority_queue<int> std_pq;
+            if(i % 3 == 0)
+                for(int x: v)
+                    std_pq.push(x);
+            for(int round = 0; round < 4; round++) {
+                size_t m = gen() % (round % 2 ? 10 : 2000);
+                std::vector<int> range(m);
+                for(int &x: range) {
+                    x = gen() % 1000000;
+                    std_pq.push(x);
+                }
+                if(round == 0)
+                    pq.push_range(range.begin(), range.end());
+                else
+                    for(int x: range)
+                        round % 2 ? pq.push(x) : pq.emplace(x);
+                for(int pops = gen() % (pq.size() + 1); pops > 0; pops--) {
+                    assert(pq.top() == std_pq.top());
+                    pq.pop();
+                    std_pq.pop();
+                }
+                assert(pq.size() == std_pq.size());
+            }
+            while(!pq.empty()) {
+                assert(pq.extract_top() == std_pq.top());
+                std_pq.pop();
+            }
+        }
+    };
+    test_d_ary_heap(d_ary_heap<int, 2>());
+    test_d_ary_heap(d_ary_heap<int, 3>());
+    test_d_ary_heap(d_ary_heap<int, 4>());
+    test_d_ary_heap(d_ary_heap<int, 8>());
+
+    // Move-only values. Top is min.
+    {
+        auto greater = [](const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) {
+            return *a > *b;
+        };
+        d_ary_heap<std::unique_ptr<int>, 4, decltype(greater)> pq(greater);
+        std::vector<std::unique_ptr<int>> v;
+        for(int i = 0; i < 100; i++)
+            v.push_back(std::make_unique<int>((i * 37) % 100));
+        pq.push_range(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+        pq.push(std::make_unique<int>(-1));
+        pq.emplace(new int(100));
+        for(int i = -1; i <= 100; i++)
+            assert(*pq.extract_top() == i);
+    }
 }
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+template<class T,
+         class Container = std::vector<T>,
+         class Compare = std::less<typename Container::value_type>>
+class priority_queue {
+    inline size_t Left(size_t k) {
+        size_t left = k * 2 + 1;
+        if(left < container_.size())
+            return left;
+        return k;
+    }
+    inline size_t Right(size_t k) {
+        size_t right = k * 2 + 2;
+        if(right < container_.size())
+            return right;
+        return k;
+    }
+    inline size_t Parent(size_t k) {
+        return (k - 1) / 2;
+    }
+    void Up() {
+        size_t k = container_.size() - 1;
+        size_t parent = Parent(k);
+
+        while(k && compare_(container_[parent], container_[k])) {
+            std::swap(container_[k], container_[parent]);
+            k = parent;
+            parent = Parent(k);
+        }
+    }
+    void Down() {
+        if(container_.size() == 0)
+            return;
+
+        size_t k = 0;
+        size_t left = Left(k);
+        size_t right = Right(k);
+
+        while(compare_(container_[k], container_[left])
+              || compare_(container_[k], container_[right])) {
+            if(compare_(container_[right], container_[left])) {
+                std::swap(container_[k], container_[left]);
+                k = left;
+            } else {
+                std::swap(container_[k], container_[right]);
+                k = right;
+            }
+            left = Left(k);
+            right = Right(k);
+        }
+    }
+
+protected:
+    Container container_;
+    Compare compare_;
+
+public:
+    priority_queue(const Compare &compare = Compare()): compare_(compare) {}
+
+    void push(const T &value) {
+        container_.push_back(value);
+        Up();
+    }
+
+    void push(T &&value) {
+        container_.push_back(std::move(value));
+        Up();
+    }
+
+    void pop() {
+        container_.front() = std::move(container_.back());
+        container_.pop_back();
+        Down();
+    }
+
+    const T &top() const {
+        return container_.front();
+    }
+
+    size_t size() const {
+        return container_.size();
+    }
+};
+
+// A priority queue on an `Arity`-ary heap. With 4 or 8 children per node, the children of a node
+// are adjacent and usually share one or two cache lines, and the tree is half or a third as deep
+// as a binary one, so `pop()` takes fewer cache misses for a few more comparisons.
+// Sifting moves a hole instead of swapping, so each element on the path is moved once, and `T` only
+// has to be movable.
+template<class T, size_t Arity = 4, class Compare = std::less<T>>
+class d_ary_heap {
+    static_assert(Arity >= 2);
+
+    std::vector<T> heap_;
+    Compare compare_;
+
+    static size_t Parent(size_t k) {
+        return (k - 1) / Arity;
+    }
+    // Move `value` up from the hole at `k`, but not above `top`.
+    void Up(size_t k, T value, size_t top = 0) {
+        while(k > top) {
+            size_t parent = Parent(k);
+            if(!compare_(heap_[parent], value))
+                break;
+            heap_[k] = std::move(heap_[parent]);
+            k = parent;
+        }
+        heap_[k] = std::move(value);
+    }
+    // Move `value` down from the hole at `k`.
+    // The hole goes all the way down to a leaf through the larger children first, and `value` then
+    // goes up from there. `value` usually comes from the bottom and belongs near it, so this saves
+    // the comparison against `value` on each level, which is the one that is hard to predict.
+    void Down(size_t k, T value) {
+        size_t top = k;
+        size_t size = heap_.size();
+        while(true) {
+            size_t first = k * Arity + 1;
+            if(first >= size)
+                break;
+            size_t child = first;
+            if(first + Arity <= size) {
+                for(size_t i = first + 1; i < first + Arity; i++)
+                    child = compare_(heap_[child], heap_[i]) ? i : child;
+            } else {
+                for(size_t i = first + 1; i < size; i++)
+                    child = compare_(heap_[child], heap_[i]) ? i : child;
+            }
+            heap_[k] = std::move(heap_[child]);
+            k = child;
+        }
+        Up(k, std::move(value), top);
+    }
+    // Floyd's bottom-up construction in O(n).
+    void Heapify() {
+        if(heap_.size() <= 1)
+            return;
+        for(size_t k = Parent(heap_.size() - 1) + 1; k-- > 0;)
+            Down(k, std::move(heap_[k]));
+    }
+
+public:
+    d_ary_heap(const Compare &compare = Compare()): compare_(compare) {}
+
+    // O(n) initialization
+    d_ary_heap(std::vector<T> values, const Compare &compare = Compare())
+        : heap_(std::move(values)), compare_(compare) {
+        Heapify();
+    }
+
+    void push(const T &value) {
+        heap_.push_back(value);
+        Up(heap_.size() - 1, std::move(heap_.back()));
+    }
+
+    void push(T &&value) {
+        heap_.push_back(std::move(value));
+        Up(heap_.size() - 1, std::move(heap_.back()));
+    }
+
+    template<class... Args>
+    void emplace(Args &&...args) {
+        heap_.emplace_back(std::forward<Args>(args)...);
+        Up(heap_.size() - 1, std::move(heap_.back()));
+    }
+
+    // Pushing `n` values one by one is O(n log(size)) in the worst case, rebuilding is O(size).
+    // Rebuild when the range is at least as large as the heap already is.
+    template<class InputIt>
+    void push_range(InputIt first, InputIt last) {
+        size_t old_size = heap_.size();
+        heap_.insert(heap_.end(), first, last);
+        if(heap_.size() - old_size >= old_size) {
+            Heapify();
+            return;
+        }
+        for(size_t k = old_size; k < heap_.size(); k++)
+            Up(k, std::move(heap_[k]));
+    }
+
+    void pop() {
+        T value = std::move(heap_.back());
+        heap_.pop_back();
+        if(!heap_.empty())
+            Down(0, std::move(value));
+    }
+
+    // Pop and return the top, e.g. a move-only value.
+    T extract_top() {
+        T top = std::move(heap_.front());
+        pop();
+        return top;
+    }
+
+    const T &top() const {
+        return heap_.front();
+    }
+
+    size_t size() const {
+        return heap_.size();
+    }
+
+    bool empty() const {
+        return heap_.empty();
+    }
+
+    void reserve(size_t n) {
+        heap_.reserve(n);
+    }
+};
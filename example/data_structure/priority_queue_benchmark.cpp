@@ -0,0 +1,188 @@
+// `d_ary_heap` of arity 2, 4 and 8 against `std::priority_queue` and `priority_queue`, on elements
+// of 4, 16 and 64 bytes ordered by their first member.
+
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "priority_queue.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+// An element of `Size` bytes, ordered by `key`.
+template<size_t Size>
+struct Element {
+    uint32_t key;
+    uint32_t payload[Size / 4 - 1];
+
+    Element() = default;
+    Element(uint32_t key): key(key) {}
+
+    bool operator<(const Element &other) const {
+        return key < other.key;
+    }
+};
+
+template<>
+struct Element<4> {
+    uint32_t key;
+
+    Element() = default;
+    Element(uint32_t key): key(key) {}
+
+    bool operator<(const Element &other) const {
+        return key < other.key;
+    }
+};
+
+vector<uint32_t> Keys(size_t n) {
+    mt19937 gen(0);
+    vector<uint32_t> keys(n);
+    for(auto &key: keys)
+        key = gen();
+    return keys;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Push `state.range(0)` random elements one by one, then pop them all. Items are elements.
+
+template<class Heap, size_t Size>
+static void BM_PushPop(benchmark::State &state) {
+    auto keys = Keys(state.range(0));
+    for(auto _: state) {
+        Heap heap;
+        for(uint32_t key: keys)
+            heap.push(Element<Size>(key));
+        while(heap.size()) {
+            benchmark::DoNotOptimize(heap.top().key);
+            heap.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define BENCHMARK_HEAPS(Size)                                                                     \
+    BENCHMARK_TEMPLATE(BM_PushPop, std::priority_queue<Element<Size>>, Size)                       \
+        ->RangeMultiplier(16)                                                                      \
+        ->Range(1 << 12, 1 << 20);                                                                 \
+    BENCHMARK_TEMPLATE(BM_PushPop, ::priority_queue<Element<Size>>, Size)                          \
+        ->RangeMultiplier(16)                                                                      \
+        ->Range(1 << 12, 1 << 20);                                                                 \
+    BENCHMARK_TEMPLATE(BM_PushPop, d_ary_heap<Element<Size>, 2>, Size)                             \
+        ->RangeMultiplier(16)                                                                      \
+        ->Range(1 << 12, 1 << 20);                                                                 \
+    BENCHMARK_TEMPLATE(BM_PushPop, d_ary_heap<Element<Size>, 4>, Size)                             \
+        ->RangeMultiplier(16)                                                                      \
+        ->Range(1 << 12, 1 << 20);                                                                 \
+    BENCHMARK_TEMPLATE(BM_PushPop, d_ary_heap<Element<Size>, 8>, Size)                             \
+        ->RangeMultiplier(16)                                                                      \
+        ->Range(1 << 12, 1 << 20);
+BENCHMARK_HEAPS(4)
+BENCHMARK_HEAPS(16)
+BENCHMARK_HEAPS(64)
+
+/*------------------------------------------------------------------------------------------------*/
+// Bulk insertion of `state.range(0)` random elements into an empty heap, then pop them all.
+// Items are elements.
+
+static void BM_PushRange_StdPriorityQueue(benchmark::State &state) {
+    auto keys = Keys(state.range(0));
+    for(auto _: state) {
+        std::priority_queue<uint32_t> heap(keys.begin(), keys.end());
+        while(heap.size())
+            heap.pop();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PushRange_StdPriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+template<size_t Arity>
+static void BM_PushRange_DAryHeap(benchmark::State &state) {
+    auto keys = Keys(state.range(0));
+    for(auto _: state) {
+        d_ary_heap<uint32_t, Arity> heap;
+        heap.push_range(keys.begin(), keys.end());
+        while(heap.size())
+            heap.pop();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PushRange_DAryHeap, 2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushRange_DAryHeap, 4)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushRange_DAryHeap, 8)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+-------------------------------------------------------------------------------------------------------------------
+Benchmark                                                         Time             CPU   Iterations UserCounters...
+-------------------------------------------------------------------------------------------------------------------
+BM_PushPop<std::priority_queue<Element<4>>, 4>/4096          473193 ns       467582 ns         1459 items_per_second=8.75996M/s
+BM_PushPop<std::priority_queue<Element<4>>, 4>/65536       10710924 ns     10537769 ns           66 items_per_second=6.21915M/s
+BM_PushPop<std::priority_queue<Element<4>>, 4>/1048576    239932515 ns    237327729 ns            3 items_per_second=4.41826M/s
+BM_PushPop<::priority_queue<Element<4>>, 4>/4096             504362 ns       482879 ns         1440 items_per_second=8.48245M/s
+BM_PushPop<::priority_queue<Element<4>>, 4>/65536          11591468 ns     11281691 ns           62 items_per_second=5.80906M/s
+BM_PushPop<::priority_queue<Element<4>>, 4>/1048576       232274743 ns    227578318 ns            3 items_per_second=4.60754M/s
+BM_PushPop<d_ary_heap<Element<4>, 2>, 4>/4096                433984 ns       430027 ns         1720 items_per_second=9.52499M/s
+BM_PushPop<d_ary_heap<Element<4>, 2>, 4>/65536             10317811 ns     10187729 ns           68 items_per_second=6.43284M/s
+BM_PushPop<d_ary_heap<Element<4>, 2>, 4>/1048576          243388764 ns    238268831 ns            3 items_per_second=4.40081M/s
+BM_PushPop<d_ary_heap<Element<4>, 4>, 4>/4096                408572 ns       403531 ns         1505 items_per_second=10.1504M/s
+BM_PushPop<d_ary_heap<Element<4>, 4>, 4>/65536              9353102 ns      9135627 ns           79 items_per_second=7.17367M/s
+BM_PushPop<d_ary_heap<Element<4>, 4>, 4>/1048576          239260883 ns    234163866 ns            3 items_per_second=4.47796M/s
+BM_PushPop<d_ary_heap<Element<4>, 8>, 4>/4096                465838 ns       461551 ns         1517 items_per_second=8.87443M/s
+BM_PushPop<d_ary_heap<Element<4>, 8>, 4>/65536             10806667 ns     10680572 ns           66 items_per_second=6.136M/s
+BM_PushPop<d_ary_heap<Element<4>, 8>, 4>/1048576          253220526 ns    249350004 ns            3 items_per_second=4.20524M/s
+BM_PushPop<std::priority_queue<Element<16>>, 16>/4096        563503 ns       560369 ns         1227 items_per_second=7.30947M/s
+BM_PushPop<std::priority_queue<Element<16>>, 16>/65536     13515389 ns     13407917 ns           52 items_per_second=4.88786M/s
+BM_PushPop<std::priority_queue<Element<16>>, 16>/1048576  382501204 ns    379708779 ns            2 items_per_second=2.76153M/s
+BM_PushPop<::priority_queue<Element<16>>, 16>/4096           600528 ns       578643 ns         1213 items_per_second=7.07864M/s
+BM_PushPop<::priority_queue<Element<16>>, 16>/65536        13397226 ns     13237565 ns           54 items_per_second=4.95076M/s
+BM_PushPop<::priority_queue<Element<16>>, 16>/1048576     384522368 ns    380156885 ns            2 items_per_second=2.75827M/s
+BM_PushPop<d_ary_heap<Element<16>, 2>, 16>/4096              345256 ns       342407 ns         2037 items_per_second=11.9624M/s
+BM_PushPop<d_ary_heap<Element<16>, 2>, 16>/65536           10668104 ns     10509878 ns           65 items_per_second=6.23566M/s
+BM_PushPop<d_ary_heap<Element<16>, 2>, 16>/1048576        519353517 ns    512859698 ns            1 items_per_second=2.04457M/s
+BM_PushPop<d_ary_heap<Element<16>, 4>, 16>/4096              417360 ns       411974 ns         1643 items_per_second=9.94237M/s
+BM_PushPop<d_ary_heap<Element<16>, 4>, 16>/65536           10098842 ns     10000705 ns           70 items_per_second=6.55314M/s
+BM_PushPop<d_ary_heap<Element<16>, 4>, 16>/1048576        272432602 ns    271573365 ns            2 items_per_second=3.86112M/s
+BM_PushPop<d_ary_heap<Element<16>, 8>, 16>/4096              425478 ns       419845 ns         1738 items_per_second=9.75599M/s
+BM_PushPop<d_ary_heap<Element<16>, 8>, 16>/65536           10829834 ns     10714683 ns           64 items_per_second=6.11647M/s
+BM_PushPop<d_ary_heap<Element<16>, 8>, 16>/1048576        272075820 ns    270121942 ns            2 items_per_second=3.88186M/s
+BM_PushPop<std::priority_queue<Element<64>>, 64>/4096        552027 ns       541024 ns         1341 items_per_second=7.57083M/s
+BM_PushPop<std::priority_queue<Element<64>>, 64>/65536     14510628 ns     14309166 ns           48 items_per_second=4.58M/s
+BM_PushPop<std::priority_queue<Element<64>>, 64>/1048576  616267047 ns    607857540 ns            1 items_per_second=1.72504M/s
+BM_PushPop<::priority_queue<Element<64>>, 64>/4096           679009 ns       673051 ns         1077 items_per_second=6.08572M/s
+BM_PushPop<::priority_queue<Element<64>>, 64>/65536        17619208 ns     17462495 ns           42 items_per_second=3.75296M/s
+BM_PushPop<::priority_queue<Element<64>>, 64>/1048576     750776155 ns    742435268 ns            1 items_per_second=1.41235M/s
+BM_PushPop<d_ary_heap<Element<64>, 2>, 64>/4096              381117 ns       378806 ns         1688 items_per_second=10.8129M/s
+BM_PushPop<d_ary_heap<Element<64>, 2>, 64>/65536           12914500 ns     12780045 ns           57 items_per_second=5.12799M/s
+BM_PushPop<d_ary_heap<Element<64>, 2>, 64>/1048576       1389280015 ns   1360676257 ns            1 items_per_second=770.629k/s
+BM_PushPop<d_ary_heap<Element<64>, 4>, 64>/4096              558979 ns       556061 ns         1260 items_per_second=7.3661M/s
+BM_PushPop<d_ary_heap<Element<64>, 4>, 64>/65536           13980338 ns     13681393 ns           50 items_per_second=4.79016M/s
+BM_PushPop<d_ary_heap<Element<64>, 4>, 64>/1048576        594695637 ns    587830644 ns            1 items_per_second=1.78381M/s
+BM_PushPop<d_ary_heap<Element<64>, 8>, 64>/4096              547699 ns       543316 ns         1300 items_per_second=7.53889M/s
+BM_PushPop<d_ary_heap<Element<64>, 8>, 64>/65536           13850594 ns     13745534 ns           51 items_per_second=4.7678M/s
+BM_PushPop<d_ary_heap<Element<64>, 8>, 64>/1048576        564122841 ns    556931132 ns            1 items_per_second=1.88277M/s
+BM_PushRange_StdPriorityQueue/4096                           447809 ns       439499 ns         1551 items_per_second=9.3197M/s
+BM_PushRange_StdPriorityQueue/65536                         9862690 ns      9695828 ns           68 items_per_second=6.7592M/s
+BM_PushRange_StdPriorityQueue/1048576                     200269806 ns    194499866 ns            3 items_per_second=5.39114M/s
+BM_PushRange_DAryHeap<2>/4096                                349697 ns       345179 ns         2000 items_per_second=11.8663M/s
+BM_PushRange_DAryHeap<2>/65536                              9048091 ns      8325862 ns           84 items_per_second=7.87138M/s
+BM_PushRange_DAryHeap<2>/1048576                          171690050 ns    169514119 ns            4 items_per_second=6.18577M/s
+BM_PushRange_DAryHeap<4>/4096                                355819 ns       346280 ns         2308 items_per_second=11.8286M/s
+BM_PushRange_DAryHeap<4>/65536                              8111135 ns      8018279 ns           92 items_per_second=8.17332M/s
+BM_PushRange_DAryHeap<4>/1048576                          171977469 ns    169673660 ns            4 items_per_second=6.17996M/s
+BM_PushRange_DAryHeap<8>/4096                                365905 ns       360144 ns         1875 items_per_second=11.3732M/s
+BM_PushRange_DAryHeap<8>/65536                              8484646 ns      8407349 ns           77 items_per_second=7.79508M/s
+BM_PushRange_DAryHeap<8>/1048576                          205070293 ns    202438468 ns            4 items_per_second=5.17973M/s
+*/
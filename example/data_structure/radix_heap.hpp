@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// A mutable monotone priority queue on a radix heap. Top is min, and keys are unsigned integers.
+// Monotone: a pushed or updated key must not be less than the last `top()`, i.e. the last popped
+// key in a pop loop, which holds for e.g. Dijkstra's algorithm and event schedulers whose clock
+// only goes forward.
+// Bucket i > 0 holds the keys whose highest bit differing from the last `top()` is bit i - 1, and
+// bucket 0 holds the keys equal to it. Each key moves to a lower bucket at most once per bit,
+// so `pop()` is O(log C) amortized for keys up to C, and `push()` and `update()` are O(1).
+// Nodes live in a pool like `pairing_heap`, and each node knows its place in its bucket, so a node
+// is taken out of its bucket in O(1) by moving the bucket's last node into its place.
+template<class Key = uint32_t>
+class radix_heap {
+    static_assert(std::is_unsigned<Key>::value);
+
+public:
+    // Valid from `push()` until the key is popped or erased.
+    using handle_type = size_t;
+
+private:
+    static constexpr int bits = sizeof(Key) * 8;
+
+    struct Node {
+        Key key;
+        int bucket;
+        size_t position; // In `buckets_[bucket]`.
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<size_t> free_; // Unused nodes in `nodes_`.
+    std::vector<size_t> buckets_[bits + 1];
+    Key last_ = 0;
+    size_t size_ = 0;
+
+    static int Bucket(Key key, Key last) {
+        uint64_t x = uint64_t(key ^ last);
+        if(!x)
+            return 0;
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return i + 1;
+#else
+        return 64 - __builtin_clzll(x);
+#endif
+    }
+    void Insert(size_t k) {
+        Node &node = nodes_[k];
+        node.bucket = Bucket(node.key, last_);
+        node.position = buckets_[node.bucket].size();
+        buckets_[node.bucket].push_back(k);
+    }
+    void Remove(size_t k) {
+        std::vector<size_t> &bucket = buckets_[nodes_[k].bucket];
+        size_t back = bucket.back();
+        bucket[nodes_[k].position] = back;
+        nodes_[back].position = nodes_[k].position;
+        bucket.pop_back();
+    }
+    // Make bucket 0 non-empty unless the heap is empty: move `last_` up to the least key of the
+    // first non-empty bucket, whose keys then all go to lower buckets.
+    void Normalize() {
+        if(!buckets_[0].empty() || !size_)
+            return;
+        int i = 1;
+        while(buckets_[i].empty())
+            i++;
+        Key least = nodes_[buckets_[i][0]].key;
+        for(size_t k: buckets_[i])
+            if(nodes_[k].key < least)
+                least = nodes_[k].key;
+        last_ = least;
+        for(size_t k: buckets_[i])
+            Insert(k); // Never into bucket `i` itself.
+        buckets_[i].clear();
+    }
+
+public:
+    // `key` must not be less than the last `top()`.
+    handle_type push(Key key) {
+        size_t k;
+        if(free_.empty()) {
+            k = nodes_.size();
+            nodes_.push_back({key, 0, 0});
+        } else {
+            k = free_.back();
+            free_.pop_back();
+            nodes_[k].key = key;
+        }
+        Insert(k);
+        size_++;
+        return k;
+    }
+
+    void pop() {
+        erase(top_handle());
+    }
+
+    void erase(const handle_type &handle) {
+        Remove(handle);
+        free_.push_back(handle);
+        size_--;
+    }
+
+    // `key` must not be less than the last `top()`.
+    void update(const handle_type &handle, Key key) {
+        Remove(handle);
+        nodes_[handle].key = key;
+        Insert(handle);
+    }
+
+    // Not `const`: the buckets are redistributed when the top is asked for, and not after each
+    // `pop()`, so that keys down to the popped one can still be pushed until then.
+    Key top() {
+        Normalize();
+        return last_;
+    }
+
+    handle_type top_handle() {
+        Normalize();
+        return buckets_[0].back();
+    }
+
+    Key get(const handle_type &handle) const {
+        return nodes_[handle].key;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+};
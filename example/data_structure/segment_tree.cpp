@@ -3,182 +3,13 @@
 
 #include <cassert>
 
+#include <algorithm>
 #include <iostream>
+#include <random>
 #include <vector>
 using namespace std;
 
-struct Info {
-    using DataType = int;
-
-    DataType sum, mi, ma;
-
-    Info() = default;
-    Info(int sum, int mi, int ma): sum(sum), mi(mi), ma(ma) {}
-    explicit Info(int val): sum(val), mi(val), ma(val) {}
-    Info(const Info &a, const Info &b) {
-        sum = a.sum + b.sum;
-        mi = min(a.mi, b.mi);
-        ma = max(a.ma, b.ma);
-    }
-
-    bool operator==(const Info &info) const {
-        return sum == info.sum && mi == info.mi && ma == info.ma;
-    }
-};
-ostream &operator<<(ostream &os, const Info &info) {
-    os << info.sum << " " << info.mi << " " << info.ma;
-    return os;
-}
-
-template<typename T>
-class SegmentTree {
-    int size_;
-    vector<T> tree_;
-
-    void Build(const vector<typename T::DataType> &data, int l, int r, int p) {
-        if(l == r) {
-            tree_[p] = T{data[l]};
-            return;
-        }
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        Build(data, l, m, l_sub);
-        Build(data, m + 1, r, r_sub);
-        tree_[p] = T(tree_[l_sub], tree_[r_sub]);
-    }
-
-    void Update(int k, int val, int l, int r, int p) {
-        assert(0 < k && k <= size_);
-        if(l == r) {
-            tree_[p] = T{val};
-            return;
-        }
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        if(k <= m)
-            Update(k, val, l, m, l_sub);
-        else
-            Update(k, val, m + 1, r, r_sub);
-        tree_[p] = T(tree_[l_sub], tree_[r_sub]);
-    }
-
-    T Query(int L, int R, int l, int r, int p) {
-        assert(L <= R);
-        if(L <= l && r <= R)
-            return tree_[p];
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        if(R <= m)
-            return Query(L, R, l, m, l_sub);
-        if(L > m)
-            return Query(L, R, m + 1, r, r_sub);
-        return T(Query(L, R, l, m, l_sub), Query(L, R, m + 1, r, r_sub));
-    }
-
-public:
-    SegmentTree(int size) {
-        size_ = size;
-        tree_.resize(size_ * 4 + 1);
-    }
-
-    // Indexes of `data` start from 1.
-    SegmentTree(const vector<typename T::DataType> &data) {
-        size_ = data.size() - 1;
-        tree_.resize(size_ * 4 + 1);
-
-        // O(nlogn) initialization
-        // for(int i = 1; i <= size_; i++)
-        //     Update(i, data[i], 1, size_, 1);
-
-        // O(logn) initialization
-        Build(data, 1, size_, 1);
-    }
-
-    void Update(int k, int val) {
-        assert(0 < k && k <= size_);
-        Update(k, val, 1, size_, 1);
-    }
-
-    T Query(int L, int R) {
-        assert(L <= R);
-        return Query(L, R, 1, size_, 1);
-    }
-};
-
-// Query the maximum of a range.
-class SegmentTreeSimple {
-    int size_;
-    vector<int> tree_;
-
-    void Build(const vector<int> &data, int l, int r, int p) {
-        if(l == r) {
-            tree_[p] = data[l];
-            return;
-        }
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        Build(data, l, m, l_sub);
-        Build(data, m + 1, r, r_sub);
-        tree_[p] = max(tree_[l_sub], tree_[r_sub]);
-    }
-
-    void Update(int k, int val, int l, int r, int p) {
-        assert(0 < k && k <= size_);
-        if(l == r) {
-            tree_[p] = val;
-            return;
-        }
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        if(k <= m)
-            Update(k, val, l, m, l_sub);
-        else
-            Update(k, val, m + 1, r, r_sub);
-        tree_[p] = max(tree_[l_sub], tree_[r_sub]);
-    }
-
-    int Query(int L, int R, int l, int r, int p) {
-        assert(L <= R);
-        if(L <= l && r <= R)
-            return tree_[p];
-        int m = (l + r) >> 1;
-        int l_sub = p << 1, r_sub = l_sub | 1;
-        if(R <= m)
-            return Query(L, R, l, m, l_sub);
-        if(L > m)
-            return Query(L, R, m + 1, r, r_sub);
-        return max(Query(L, R, l, m, l_sub), Query(L, R, m + 1, r, r_sub));
-    }
-
-public:
-    SegmentTreeSimple(int size) {
-        size_ = size;
-        tree_.resize(size_ * 4 + 1);
-    }
-
-    // Indexes of `data` start from 1.
-    SegmentTreeSimple(const vector<int> &data) {
-        size_ = data.size() - 1;
-        tree_.resize(size_ * 4 + 1);
-
-        // O(nlogn) initialization
-        // for(int i = 1; i <= size_; i++)
-        //     Update(i, data[i], 1, size_, 1);
-
-        // O(logn) initialization
-        Build(data, 1, size_, 1);
-    }
-
-    void Update(int k, int val) {
-        assert(0 < k && k <= size_);
-        Update(k, val, 1, size_, 1);
-    }
-
-    int Query(int L, int R) {
-        assert(L <= R);
-        return Query(L, R, 1, size_, 1);
-    }
-};
+#include "segment_tree.hpp"
 
 int main() {
     // clang-format off
@@ -268,5 +99,81 @@ int main() {
         // clang-format on
     }
 
+    {
+        LazySegmentTree<Info> st(data);
+
+        // clang-format off
+        //                           sum min max
+        assert(st.Query(1, 9) == Info(45, 1, 9));
+        assert(st.Query(3, 6) == Info(18, 2, 8));
+        assert(st.Query(7, 9) == Info(17, 4, 7));
+
+        st.Add(2, 5, 10); // 1 19 12 15 13 8 6 4 7
+        assert(st.Query(1, 9) == Info(85, 1,19));
+        assert(st.Query(3, 6) == Info(48, 8,15));
+
+        st.Assign(4, 8, 0); // 1 19 12 0 0 0 0 0 7
+        assert(st.Query(1, 9) == Info(39, 0,19));
+        assert(st.Query(3, 4) == Info(12, 0,12));
+        assert(st.Query(9, 9) == Info( 7, 7, 7));
+
+        st.Update(6, 3); // 1 19 12 0 0 3 0 0 7
+        assert(st.Query(5, 7) == Info( 3, 0, 3));
+        // clang-format on
+
+        vector<Info> out;
+        st.Query({{1, 9}, {2, 2}, {6, 9}}, out);
+        assert(out == vector<Info>({Info(42, 0, 19), Info(19, 19, 19), Info(10, 0, 7)}));
+    }
+
+    // Random updates and queries, single and batched, against an array.
+    mt19937 gen(0);
+    for(int t = 0; t < 200; t++) {
+        int n = gen() % 100 + 1;
+        vector<int> a(n + 1);
+        for(int i = 1; i <= n; i++)
+            a[i] = gen() % 100;
+        LazySegmentTree<Info> st(a);
+        auto expected = [&](int l, int r) {
+            Info info(a[l]);
+            for(int i = l + 1; i <= r; i++)
+                info = Info(info, Info(a[i]));
+            return info;
+        };
+        for(int op = 0; op < 200; op++) {
+            int l = gen() % n + 1, r = gen() % n + 1;
+            if(l > r)
+                swap(l, r);
+            int value = int(gen() % 100) - 50;
+            switch(gen() % 4) {
+            case 0:
+                st.Add(l, r, value);
+                for(int i = l; i <= r; i++)
+                    a[i] += value;
+                break;
+            case 1:
+                st.Assign(l, r, value);
+                for(int i = l; i <= r; i++)
+                    a[i] = value;
+                break;
+            case 2: assert(st.Query(l, r) == expected(l, r)); break;
+            case 3: {
+                vector<pair<int, int>> ranges(gen() % (n * 2) + 1);
+                for(auto &[l, r]: ranges) {
+                    l = gen() % n + 1;
+                    r = gen() % n + 1;
+                    if(l > r)
+                        swap(l, r);
+                }
+                vector<Info> out;
+                st.Query(ranges, out);
+                for(size_t i = 0; i < ranges.size(); i++)
+                    assert(out[i] == expected(ranges[i].first, ranges[i].second));
+                break;
+            }
+            }
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// A pending update of a range: assign `value` if `assign`, then add `add`.
+struct InfoUpdate {
+    using DataType = int;
+
+    bool assign = false;
+    DataType value = 0, add = 0;
+
+    static InfoUpdate Assign(DataType value) {
+        return {true, value, 0};
+    }
+    static InfoUpdate Add(DataType add) {
+        return {false, 0, add};
+    }
+
+    // No update.
+    bool empty() const {
+        return !assign && !add;
+    }
+
+    // Apply `u` after this.
+    void Compose(const InfoUpdate &u) {
+        if(u.assign)
+            *this = u;
+        else
+            add += u.add;
+    }
+};
+
+struct Info {
+    using DataType = int;
+    using UpdateType = InfoUpdate;
+
+    DataType sum, mi, ma;
+
+    Info() = default;
+    Info(int sum, int mi, int ma): sum(sum), mi(mi), ma(ma) {}
+    explicit Info(int val): sum(val), mi(val), ma(val) {}
+    Info(const Info &a, const Info &b) {
+        sum = a.sum + b.sum;
+        mi = std::min(a.mi, b.mi);
+        ma = std::max(a.ma, b.ma);
+    }
+
+    // Apply `u` to all `len` elements.
+    void Apply(const InfoUpdate &u, int len) {
+        if(u.assign) {
+            sum = u.value * len;
+            mi = ma = u.value;
+        }
+        sum += u.add * len;
+        mi += u.add;
+        ma += u.add;
+    }
+
+    bool operator==(const Info &info) const {
+        return sum == info.sum && mi == info.mi && ma == info.ma;
+    }
+};
+inline std::ostream &operator<<(std::ostream &os, const Info &info) {
+    os << info.sum << " " << info.mi << " " << info.ma;
+    return os;
+}
+
+template<typename T>
+class SegmentTree {
+    int size_;
+    std::vector<T> tree_;
+
+    void Build(const std::vector<typename T::DataType> &data, int l, int r, int p) {
+        if(l == r) {
+            tree_[p] = T{data[l]};
+            return;
+        }
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        Build(data, l, m, l_sub);
+        Build(data, m + 1, r, r_sub);
+        tree_[p] = T(tree_[l_sub], tree_[r_sub]);
+    }
+
+    void Update(int k, int val, int l, int r, int p) {
+        assert(0 < k && k <= size_);
+        if(l == r) {
+            tree_[p] = T{val};
+            return;
+        }
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        if(k <= m)
+            Update(k, val, l, m, l_sub);
+        else
+            Update(k, val, m + 1, r, r_sub);
+        tree_[p] = T(tree_[l_sub], tree_[r_sub]);
+    }
+
+    T Query(int L, int R, int l, int r, int p) {
+        assert(L <= R);
+        if(L <= l && r <= R)
+            return tree_[p];
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        if(R <= m)
+            return Query(L, R, l, m, l_sub);
+        if(L > m)
+            return Query(L, R, m + 1, r, r_sub);
+        return T(Query(L, R, l, m, l_sub), Query(L, R, m + 1, r, r_sub));
+    }
+
+public:
+    SegmentTree(int size) {
+        size_ = size;
+        tree_.resize(size_ * 4 + 1);
+    }
+
+    // Indexes of `data` start from 1.
+    SegmentTree(const std::vector<typename T::DataType> &data) {
+        size_ = data.size() - 1;
+        tree_.resize(size_ * 4 + 1);
+
+        // O(nlogn) initialization
+        // for(int i = 1; i <= size_; i++)
+        //     Update(i, data[i], 1, size_, 1);
+
+        // O(logn) initialization
+        Build(data, 1, size_, 1);
+    }
+
+    void Update(int k, int val) {
+        assert(0 < k && k <= size_);
+        Update(k, val, 1, size_, 1);
+    }
+
+    T Query(int L, int R) {
+        assert(L <= R);
+        return Query(L, R, 1, size_, 1);
+    }
+};
+
+// Query the maximum of a range.
+class SegmentTreeSimple {
+    int size_;
+    std::vector<int> tree_;
+
+    void Build(const std::vector<int> &data, int l, int r, int p) {
+        if(l == r) {
+            tree_[p] = data[l];
+            return;
+        }
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        Build(data, l, m, l_sub);
+        Build(data, m + 1, r, r_sub);
+        tree_[p] = std::max(tree_[l_sub], tree_[r_sub]);
+    }
+
+    void Update(int k, int val, int l, int r, int p) {
+        assert(0 < k && k <= size_);
+        if(l == r) {
+            tree_[p] = val;
+            return;
+        }
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        if(k <= m)
+            Update(k, val, l, m, l_sub);
+        else
+            Update(k, val, m + 1, r, r_sub);
+        tree_[p] = std::max(tree_[l_sub], tree_[r_sub]);
+    }
+
+    int Query(int L, int R, int l, int r, int p) {
+        assert(L <= R);
+        if(L <= l && r <= R)
+            return tree_[p];
+        int m = (l + r) >> 1;
+        int l_sub = p << 1, r_sub = l_sub | 1;
+        if(R <= m)
+            return Query(L, R, l, m, l_sub);
+        if(L > m)
+            return Query(L, R, m + 1, r, r_sub);
+        return std::max(Query(L, R, l, m, l_sub), Query(L, R, m + 1, r, r_sub));
+    }
+
+public:
+    SegmentTreeSimple(int size) {
+        size_ = size;
+        tree_.resize(size_ * 4 + 1);
+    }
+
+    // Indexes of `data` start from 1.
+    SegmentTreeSimple(const std::vector<int> &data) {
+        size_ = data.size() - 1;
+        tree_.resize(size_ * 4 + 1);
+
+        // O(nlogn) initialization
+        // for(int i = 1; i <= size_; i++)
+        //     Update(i, data[i], 1, size_, 1);
+
+        // O(logn) initialization
+        Build(data, 1, size_, 1);
+    }
+
+    void Update(int k, int val) {
+        assert(0 < k && k <= size_);
+        Update(k, val, 1, size_, 1);
+    }
+
+    int Query(int L, int R) {
+        assert(L <= R);
+        return Query(L, R, 1, size_, 1);
+    }
+};
+
+// Bottom-up segment tree with lazy range updates.
+// The size is rounded up to a power of two, and nodes are in heap order, i.e. node `k` has
+// children `2k` and `2k + 1`, and leaves are [size, 2 * size). So it takes 2 * size nodes instead
+// of 4n, walks the tree with loops instead of recursion, and the top levels, which every operation
+// goes through, are close together in memory.
+// `T` is a policy like `Info`:
+//     `T{value}` is a leaf, `T(a, b)` combines two adjacent ranges,
+//     `T::UpdateType` is a range update, default constructed as no update, which composes with
+//     `Compose()` and tells if it's no update with `empty()`, and
+//     `T::Apply(u, len)` applies it to a node of `len` elements.
+// A node's update is kept pending, and pushed down to its children only before an operation goes
+// below the node.
+template<typename T>
+class LazySegmentTree {
+    using U = typename T::UpdateType;
+
+    int n_, size_, log_;
+    std::vector<T> tree_;
+    std::vector<U> lazy_; // Pending updates of the internal nodes.
+
+    void Apply(int k, const U &u, int len) {
+        tree_[k].Apply(u, len);
+        if(k < size_)
+            lazy_[k].Compose(u);
+    }
+    // Push the pending update of node `k` of level `i` (of `1 << i` elements) to its children.
+    void Push(int k, int i) {
+        if(lazy_[k].empty())
+            return;
+        Apply(k << 1, lazy_[k], 1 << (i - 1));
+        Apply(k << 1 | 1, lazy_[k], 1 << (i - 1));
+        lazy_[k] = U();
+    }
+    void Pull(int k) {
+        tree_[k] = T(tree_[k << 1], tree_[k << 1 | 1]);
+    }
+    // Push the pending updates of the ancestors of the boundaries of leaves [l, r), from the top.
+    void PushBoundaries(int l, int r) {
+        for(int i = log_; i >= 1; i--) {
+            if(((l >> i) << i) != l)
+                Push(l >> i, i);
+            if(((r >> i) << i) != r)
+                Push((r - 1) >> i, i);
+        }
+    }
+
+    // Query leaves [l, r), whose ancestors have no pending updates.
+    T QueryPushed(int l, int r) const {
+        // `left` covers from `l` to the left boundary, `right` from the right boundary to `r`.
+        T left, right;
+        bool has_left = false, has_right = false;
+        for(; l < r; l >>= 1, r >>= 1) {
+            if(l & 1) {
+                left = has_left ? T(left, tree_[l]) : tree_[l];
+                has_left = true;
+                l++;
+            }
+            if(r & 1) {
+                r--;
+                right = has_right ? T(tree_[r], right) : tree_[r];
+                has_right = true;
+            }
+        }
+        if(!has_left)
+            return right;
+        if(!has_right)
+            return left;
+        return T(left, right);
+    }
+
+public:
+    // Indexes of `data` start from 1.
+    LazySegmentTree(const std::vector<typename T::DataType> &data) {
+        n_ = data.size() - 1;
+        size_ = 1;
+        log_ = 0;
+        while(size_ < n_) {
+            size_ <<= 1;
+            log_++;
+        }
+        tree_.resize(size_ * 2, T{typename T::DataType()});
+        lazy_.resize(size_);
+        for(int i = 1; i <= n_; i++)
+            tree_[size_ + i - 1] = T{data[i]};
+        // Leaves beyond `n` are never in a query or an update, so their values don't matter.
+        for(int k = size_ - 1; k >= 1; k--)
+            Pull(k);
+    }
+
+    // Apply `u` to [L, R].
+    void Update(int L, int R, const U &u) {
+        assert(1 <= L && L <= R && R <= n_);
+        int l = L - 1 + size_, r = R + size_;
+        PushBoundaries(l, r);
+        for(int l2 = l, r2 = r, len = 1; l2 < r2; l2 >>= 1, r2 >>= 1, len <<= 1) {
+            if(l2 & 1)
+                Apply(l2++, u, len);
+            if(r2 & 1)
+                Apply(--r2, u, len);
+        }
+        for(int i = 1; i <= log_; i++) {
+            if(((l >> i) << i) != l)
+                Pull(l >> i);
+            if(((r >> i) << i) != r)
+                Pull((r - 1) >> i);
+        }
+    }
+
+    void Assign(int L, int R, typename T::DataType value) {
+        Update(L, R, U::Assign(value));
+    }
+    void Add(int L, int R, typename T::DataType value) {
+        Update(L, R, U::Add(value));
+    }
+    // Point update, like `SegmentTree::Update()`.
+    void Update(int k, typename T::DataType value) {
+        Assign(k, k, value);
+    }
+
+    T Query(int L, int R) {
+        assert(1 <= L && L <= R && R <= n_);
+        int l = L - 1 + size_, r = R + size_;
+        PushBoundaries(l, r);
+        return QueryPushed(l, r);
+    }
+
+    // `out[i]` is `Query(ranges[i].first, ranges[i].second)`.
+    // If pushing all pending updates down at once, in O(n), is cheaper than pushing along the
+    // boundaries of each range, in O(logn) each, that's done first and the queries don't push.
+    void Query(const std::vector<std::pair<int, int>> &ranges, std::vector<T> &out) {
+        out.resize(ranges.size());
+        bool flush = ranges.size() * log_ >= size_t(size_);
+        if(flush)
+            for(int i = log_, k = 1; i >= 1; i--)
+                for(int end = k << 1; k < end; k++)
+                    Push(k, i);
+        for(size_t i = 0; i < ranges.size(); i++) {
+            auto [L, R] = ranges[i];
+            assert(1 <= L && L <= R && R <= n_);
+            int l = L - 1 + size_, r = R + size_;
+            if(!flush)
+                PushBoundaries(l, r);
+            out[i] = QueryPushed(l, r);
+        }
+    }
+};
@@ -0,0 +1,156 @@
+// `LazySegmentTree` against the recursive `SegmentTree` and `SegmentTreeSimple`: point updates and
+// range queries, which all of them support, then range updates and batched queries.
+
+#include <random>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "segment_tree.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n = 1 << 20;
+constexpr int n_op = 1 << 16;
+
+const vector<int> &Data() {
+    static vector<int> data = [] {
+        mt19937 gen(0);
+        vector<int> data(n + 1);
+        for(int i = 1; i <= n; i++)
+            data[i] = gen() % 1000;
+        return data;
+    }();
+    return data;
+}
+
+// Random `[L, R]` ranges in [1, n].
+vector<pair<int, int>> Ranges(int count) {
+    mt19937 gen(1);
+    vector<pair<int, int>> ranges(count);
+    for(auto &[l, r]: ranges) {
+        l = gen() % n + 1;
+        r = gen() % n + 1;
+        if(l > r)
+            swap(l, r);
+    }
+    return ranges;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// Half point updates, half range queries. Items are operations.
+
+template<typename Tree>
+void PointUpdateRangeQuery(benchmark::State &state) {
+    Tree tree(Data());
+    auto ranges = Ranges(n_op);
+    for(auto _: state)
+        for(int i = 0; i < n_op; i++) {
+            auto [l, r] = ranges[i];
+            if(i & 1)
+                benchmark::DoNotOptimize(tree.Query(l, r));
+            else
+                tree.Update(l, r);
+        }
+    state.SetItemsProcessed(state.iterations() * n_op);
+}
+
+static void BM_SegmentTree(benchmark::State &state) {
+    PointUpdateRangeQuery<SegmentTree<Info>>(state);
+}
+BENCHMARK(BM_SegmentTree);
+
+static void BM_SegmentTreeSimple(benchmark::State &state) {
+    PointUpdateRangeQuery<SegmentTreeSimple>(state);
+}
+BENCHMARK(BM_SegmentTreeSimple);
+
+static void BM_LazySegmentTree(benchmark::State &state) {
+    PointUpdateRangeQuery<LazySegmentTree<Info>>(state);
+}
+BENCHMARK(BM_LazySegmentTree);
+
+/*------------------------------------------------------------------------------------------------*/
+// Range updates. Items are operations.
+
+// Half range adds or assigns, half range queries.
+static void BM_LazySegmentTree_RangeUpdate(benchmark::State &state) {
+    LazySegmentTree<Info> tree(Data());
+    auto ranges = Ranges(n_op);
+    for(auto _: state)
+        for(int i = 0; i < n_op; i++) {
+            auto [l, r] = ranges[i];
+            if(i & 1)
+                benchmark::DoNotOptimize(tree.Query(l, r));
+            else if(i & 2)
+                tree.Add(l, r, 1);
+            else
+                tree.Assign(l, r, i);
+        }
+    state.SetItemsProcessed(state.iterations() * n_op);
+}
+BENCHMARK(BM_LazySegmentTree_RangeUpdate);
+
+// `state.range(0)` queries after each range add, one by one.
+static void BM_LazySegmentTree_Queries(benchmark::State &state) {
+    LazySegmentTree<Info> tree(Data());
+    auto ranges = Ranges(n_op);
+    int batch = state.range(0);
+    for(auto _: state)
+        for(int i = 0; i < n_op; i += batch) {
+            tree.Add(ranges[i].first, ranges[i].second, 1);
+            for(int j = i; j < i + batch; j++)
+                benchmark::DoNotOptimize(tree.Query(ranges[j].first, ranges[j].second));
+        }
+    state.SetItemsProcessed(state.iterations() * n_op);
+}
+BENCHMARK(BM_LazySegmentTree_Queries)->RangeMultiplier(16)->Range(16, n_op);
+
+// `state.range(0)` queries after each range add, in one batch.
+static void BM_LazySegmentTree_BatchedQueries(benchmark::State &state) {
+    LazySegmentTree<Info> tree(Data());
+    auto ranges = Ranges(n_op);
+    int batch = state.range(0);
+    vector<vector<pair<int, int>>> batches;
+    for(int i = 0; i < n_op; i += batch)
+        batches.emplace_back(ranges.begin() + i, ranges.begin() + i + batch);
+    vector<Info> out;
+    for(auto _: state)
+        for(const auto &batch_ranges: batches) {
+            tree.Add(batch_ranges[0].first, batch_ranges[0].second, 1);
+            tree.Query(batch_ranges, out);
+            benchmark::DoNotOptimize(out.data());
+        }
+    state.SetItemsProcessed(state.iterations() * n_op);
+}
+BENCHMARK(BM_LazySegmentTree_BatchedQueries)->RangeMultiplier(16)->Range(16, n_op);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+--------------------------------------------------------------------------------------------------
+Benchmark                                        Time             CPU   Iterations UserCounters...
+--------------------------------------------------------------------------------------------------
+BM_SegmentTree                            36095836 ns     35359225 ns           18 items_per_second=1.85343M/s
+BM_SegmentTreeSimple                      21124811 ns     20988893 ns           35 items_per_second=3.12241M/s
+BM_LazySegmentTree                        29117295 ns     28450959 ns           32 items_per_second=2.30347M/s
+BM_LazySegmentTree_RangeUpdate            55602349 ns     54314019 ns           10 items_per_second=1.20661M/s
+BM_LazySegmentTree_Queries/16             45886528 ns     44469679 ns           15 items_per_second=1.47372M/s
+BM_LazySegmentTree_Queries/256            44526239 ns     44136099 ns           13 items_per_second=1.48486M/s
+BM_LazySegmentTree_Queries/4096           37476872 ns     37166267 ns           19 items_per_second=1.76332M/s
+BM_LazySegmentTree_Queries/65536          33619159 ns     32638524 ns           23 items_per_second=2.00793M/s
+BM_LazySegmentTree_BatchedQueries/16      49133950 ns     48759372 ns           13 items_per_second=1.34407M/s
+BM_LazySegmentTree_BatchedQueries/256     44851576 ns     44333518 ns           15 items_per_second=1.47825M/s
+BM_LazySegmentTree_BatchedQueries/4096    34551518 ns     34218901 ns           18 items_per_second=1.9152M/s
+BM_LazySegmentTree_BatchedQueries/65536   16896529 ns     16757528 ns           35 items_per_second=3.91084M/s
+
+*/
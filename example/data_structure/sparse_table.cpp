@@ -3,43 +3,12 @@
 
 #include <cassert>
 
+#include <functional>
+#include <random>
 #include <vector>
 using namespace std;
 
-class SparseTable {
-    int size_;
-    vector<int> log2_;
-    vector<int> exp2_;
-    vector<vector<int>> dp_;
-
-public:
-    // Indexes of `data` start from 1.
-    SparseTable(const vector<int> &data) {
-        size_ = data.size() - 1;
-
-        log2_.resize(size_ + 1);
-        for(int i = 2; i <= size_; i++)
-            log2_[i] = log2_[i >> 1] + 1; // Pre-compute table of `log2()`.
-
-        exp2_.resize(log2_[size_] + 1);
-        exp2_[0] = 1;
-        for(int i = 1; i <= log2_[size_]; i++)
-            exp2_[i] = exp2_[i - 1] * 2; // Pre-compute table of `exp2()`.
-
-        dp_.resize(log2_[size_] + 1, vector<int>(size_ + 1));
-        for(int i = 1; i <= size_; i++)
-            dp_[0][i] = data[i];
-        for(int j = 1; j <= log2_[size_]; j++)
-            for(int i = 1; i + exp2_[j] - 1 <= size_; i++)
-                dp_[j][i] = max(dp_[j - 1][i], dp_[j - 1][i + exp2_[j - 1]]);
-    }
-
-    int Query(int l, int r) {
-        assert(l <= r && l > 0 && r <= size_);
-        int e = log2_[r - l + 1];
-        return max(dp_[e][l], dp_[e][r - exp2_[e] + 1]);
-    }
-};
+#include "sparse_table.hpp"
 
 int main() {
     // clang-format off
@@ -49,6 +18,7 @@ int main() {
     // clang-format on
 
     SparseTable st(data);
+    BlockSparseTable<int, greater<int>> bst(data);
 
     // st.Query(0, 9); // error
     // st.Query(1,10); // error
@@ -84,5 +54,34 @@ int main() {
 
     assert(st.Query(9, 9) == 7);
 
+    for(int l = 1; l <= 9; l++)
+        for(int r = l; r <= 9; r++)
+            assert(bst.Query(l, r) == st.Query(l, r));
+
+    // Random data, min and max, within one block and across blocks, against a scan.
+    mt19937 gen(0);
+    for(int t = 0; t < 100; t++) {
+        int n = gen() % 1000 + 1;
+        vector<double> data(n + 1);
+        for(int i = 1; i <= n; i++)
+            data[i] = gen() % (t % 2 ? 10 : 1000000); // Many equal values, or few.
+        BlockSparseTable<double> bst_min(data);
+        BlockSparseTable<double, greater<double>> bst_max(data);
+        for(int q = 0; q < 1000; q++) {
+            int l = gen() % n + 1, r = gen() % n + 1;
+            if(l > r)
+                swap(l, r);
+            if(q % 2)
+                r = min(n, l + int(gen() % 40)); // Short, often in one block.
+            double mi = data[l], ma = data[l];
+            for(int i = l + 1; i <= r; i++) {
+                mi = min(mi, data[i]);
+                ma = max(ma, data[i]);
+            }
+            assert(bst_min.Query(l, r) == mi);
+            assert(bst_max.Query(l, r) == ma);
+        }
+    }
+
     return 0;
 }
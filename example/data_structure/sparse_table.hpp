@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class SparseTable {
+    int size_;
+    std::vector<int> log2_;
+    std::vector<int> exp2_;
+    std::vector<std::vector<int>> dp_;
+
+public:
+    // Indexes of `data` start from 1.
+    SparseTable(const std::vector<int> &data) {
+        size_ = data.size() - 1;
+
+        log2_.resize(size_ + 1);
+        for(int i = 2; i <= size_; i++)
+            log2_[i] = log2_[i >> 1] + 1; // Pre-compute table of `log2()`.
+
+        exp2_.resize(log2_[size_] + 1);
+        exp2_[0] = 1;
+        for(int i = 1; i <= log2_[size_]; i++)
+            exp2_[i] = exp2_[i - 1] * 2; // Pre-compute table of `exp2()`.
+
+        dp_.resize(log2_[size_] + 1, std::vector<int>(size_ + 1));
+        for(int i = 1; i <= size_; i++)
+            dp_[0][i] = data[i];
+        for(int j = 1; j <= log2_[size_]; j++)
+            for(int i = 1; i + exp2_[j] - 1 <= size_; i++)
+                dp_[j][i] = std::max(dp_[j - 1][i], dp_[j - 1][i + exp2_[j - 1]]);
+    }
+
+    int Query(int l, int r) {
+        assert(l <= r && l > 0 && r <= size_);
+        int e = log2_[r - l + 1];
+        return std::max(dp_[e][l], dp_[e][r - exp2_[e] + 1]);
+    }
+};
+
+// Block-based RMQ in O(n) memory with O(1) queries.
+// `Compare` is `std::less<T>` for the minimum, or `std::greater<T>` for the maximum.
+// The data is split into blocks of 32.
+//     Inside a block: `mask_[i]` has bit `j` set iff element `j` of the block is better than every
+//     later element up to `i`, i.e. on the monotonic stack after pushing `i`. So the best of
+//     [l, i] in one block is the lowest bit of `mask_[i]` at or above `l`.
+//     Across blocks: a sparse table of the best of each block, on n / 32 blocks.
+// So memory is n words of `T` (a copy of the data), n masks of 32 bits, and (n / 32) * log(n / 32)
+// words of `T`, about 3n words in all, against n * logn words of `SparseTable`.
+template<typename T, typename Compare = std::less<T>>
+class BlockSparseTable {
+    static constexpr int block_bits = 5;
+    static constexpr int block = 1 << block_bits;
+
+    int size_, n_block_;
+    std::vector<T> data_;
+    std::vector<uint32_t> mask_;
+    // Level `j` is `table_[j * n_block_ + i]`, the best of blocks [i, i + 2^j).
+    std::vector<T> table_;
+    Compare compare_;
+
+    static int CountrZero(uint32_t x) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward(&i, x);
+        return i;
+#else
+        return __builtin_ctz(x);
+#endif
+    }
+    static int Log2(uint32_t x) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanReverse(&i, x);
+        return i;
+#else
+        return 31 - __builtin_clz(x);
+#endif
+    }
+
+    const T &Best(const T &a, const T &b) const {
+        return compare_(b, a) ? b : a;
+    }
+
+    // Best of [l, r], 0-based, in one block.
+    const T &InBlock(int l, int r) const {
+        uint32_t m = mask_[r] & (~uint32_t(0) << (l & (block - 1)));
+        return data_[(r & ~(block - 1)) + CountrZero(m)];
+    }
+
+public:
+    // Indexes of `data` start from 1.
+    BlockSparseTable(const std::vector<T> &data, const Compare &compare = Compare())
+        : size_(data.size() - 1)
+        , n_block_((size_ + block - 1) >> block_bits)
+        , data_(data.begin() + 1, data.end())
+        , mask_(size_)
+        , compare_(compare) {
+        for(int b = 0; b < n_block_; b++) {
+            uint32_t m = 0;
+            int begin = b << block_bits;
+            for(int i = begin; i < size_ && i < begin + block; i++) {
+                // Pop the elements which aren't better than `i`.
+                while(m && !compare_(data_[begin + Log2(m)], data_[i]))
+                    m &= ~(uint32_t(1) << Log2(m));
+                m |= uint32_t(1) << (i - begin);
+                mask_[i] = m;
+            }
+        }
+
+        int levels = n_block_ ? Log2(n_block_) + 1 : 0;
+        table_.resize(size_t(levels) * n_block_);
+        for(int b = 0; b < n_block_; b++)
+            table_[b] = InBlock(b << block_bits, std::min(size_, (b + 1) << block_bits) - 1);
+        for(int j = 1; j < levels; j++) {
+            const T *prev = &table_[size_t(j - 1) * n_block_];
+            T *cur = &table_[size_t(j) * n_block_];
+            for(int i = 0; i + (1 << j) <= n_block_; i++)
+                cur[i] = Best(prev[i], prev[i + (1 << (j - 1))]);
+        }
+    }
+
+    T Query(int l, int r) const {
+        assert(l <= r && l > 0 && r <= size_);
+        l--;
+        r--;
+        int bl = l >> block_bits, br = r >> block_bits;
+        if(bl == br)
+            return InBlock(l, r);
+        T best = Best(InBlock(l, (bl << block_bits) + block - 1), InBlock(br << block_bits, r));
+        if(++bl < br--) {
+            int e = Log2(br - bl + 1);
+            const T *level = &table_[size_t(e) * n_block_];
+            best = Best(best, Best(level[bl], level[br - (1 << e) + 1]));
+        }
+        return best;
+    }
+
+    // Bytes of memory used, not counting the object itself.
+    size_t bytes() const {
+        return (data_.size() + table_.size()) * sizeof(T) + mask_.size() * sizeof(uint32_t);
+    }
+};
@@ -0,0 +1,140 @@
+// `BlockSparseTable` against `SparseTable`: memory (`bytes`), build time and query latency, for
+// random ranges of any length and short ranges of at most 64 elements.
+
+#include <functional>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "sparse_table.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+constexpr int n_query = 1 << 16;
+
+// `n` random elements, indexes start from 1.
+const vector<int> &Data(int n) {
+    static map<int, vector<int>> cache;
+    auto it = cache.find(n);
+    if(it == cache.end()) {
+        mt19937 gen(n);
+        vector<int> data(n + 1);
+        for(int i = 1; i <= n; i++)
+            data[i] = gen();
+        it = cache.emplace(n, move(data)).first;
+    }
+    return it->second;
+}
+
+// Random `[l, r]` ranges in [1, n], at most `max_len` long if not 0.
+vector<pair<int, int>> Ranges(int n, int max_len) {
+    mt19937 gen(0);
+    vector<pair<int, int>> ranges(n_query);
+    for(auto &[l, r]: ranges) {
+        l = gen() % n + 1;
+        r = max_len ? min(n, l + int(gen() % max_len)) : gen() % n + 1;
+        if(l > r)
+            swap(l, r);
+    }
+    return ranges;
+}
+
+// Bytes of `SparseTable` on `n` elements: `dp_` of logn + 1 rows of n + 1, and `log2_`.
+size_t SparseTableBytes(int n) {
+    int log = 0;
+    while((2 << log) <= n)
+        log++;
+    return (size_t(log + 1) * (n + 1) + (n + 1)) * sizeof(int);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the size. Items are elements.
+
+static void BM_SparseTable_Build(benchmark::State &state) {
+    const vector<int> &data = Data(state.range(0));
+    for(auto _: state)
+        benchmark::DoNotOptimize(SparseTable(data));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = SparseTableBytes(state.range(0));
+}
+BENCHMARK(BM_SparseTable_Build)->RangeMultiplier(16)->Range(1 << 14, 1 << 22);
+
+static void BM_BlockSparseTable_Build(benchmark::State &state) {
+    const vector<int> &data = Data(state.range(0));
+    size_t bytes = 0;
+    for(auto _: state) {
+        BlockSparseTable<int, greater<int>> table(data);
+        bytes = table.bytes();
+        benchmark::DoNotOptimize(table);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = bytes;
+}
+BENCHMARK(BM_BlockSparseTable_Build)->RangeMultiplier(16)->Range(1 << 14, 1 << 26);
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` is the size, `state.range(1)` is the max range length, or 0 for any. Items are
+// queries.
+
+static void BM_SparseTable_Query(benchmark::State &state) {
+    SparseTable table(Data(state.range(0)));
+    auto ranges = Ranges(state.range(0), state.range(1));
+    for(auto _: state)
+        for(auto [l, r]: ranges)
+            benchmark::DoNotOptimize(table.Query(l, r));
+    state.SetItemsProcessed(state.iterations() * n_query);
+}
+BENCHMARK(BM_SparseTable_Query)->ArgsProduct({{1 << 14, 1 << 18, 1 << 22}, {0, 64}});
+
+static void BM_BlockSparseTable_Query(benchmark::State &state) {
+    BlockSparseTable<int, greater<int>> table(Data(state.range(0)));
+    auto ranges = Ranges(state.range(0), state.range(1));
+    for(auto _: state)
+        for(auto [l, r]: ranges)
+            benchmark::DoNotOptimize(table.Query(l, r));
+    state.SetItemsProcessed(state.iterations() * n_query);
+}
+BENCHMARK(BM_BlockSparseTable_Query)->ArgsProduct({{1 << 14, 1 << 18, 1 << 22, 1 << 26}, {0, 64}});
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+------------------------------------------------------------------------------------------------
+Benchmark                                      Time             CPU   Iterations UserCounters...
+------------------------------------------------------------------------------------------------
+BM_SparseTable_Build/16384                791906 ns       785182 ns          857 bytes=1048.64k items_per_second=20.8665M/s
+BM_SparseTable_Build/65536               2620245 ns      2605928 ns          222 bytes=4.71866M items_per_second=25.1488M/s
+BM_SparseTable_Build/1048576            75373890 ns     74367638 ns           10 bytes=92.2748M items_per_second=14.0999M/s
+BM_SparseTable_Build/4194304           437200003 ns    431921627 ns            2 bytes=402.653M items_per_second=9.7108M/s
+BM_BlockSparseTable_Build/16384           188320 ns       187018 ns         3942 bytes=151.552k items_per_second=87.6065M/s
+BM_BlockSparseTable_Build/65536           950225 ns       941977 ns          760 bytes=622.592k items_per_second=69.5728M/s
+BM_BlockSparseTable_Build/1048576       17950876 ns     17425728 ns           40 bytes=10.4858M items_per_second=60.174M/s
+BM_BlockSparseTable_Build/16777216     386664257 ns    384779105 ns            2 bytes=176.161M items_per_second=43.6022M/s
+BM_BlockSparseTable_Build/67108864    1987767074 ns   1966416892 ns            1 bytes=721.42M items_per_second=34.1275M/s
+BM_SparseTable_Query/16384/0              295303 ns       291742 ns         2647 items_per_second=224.637M/s
+BM_SparseTable_Query/262144/0             732258 ns       724174 ns          851 items_per_second=90.4976M/s
+BM_SparseTable_Query/4194304/0           1313951 ns      1299602 ns          553 items_per_second=50.4277M/s
+BM_SparseTable_Query/16384/64             145144 ns       142241 ns         5367 items_per_second=460.74M/s
+BM_SparseTable_Query/262144/64            537885 ns       532500 ns         1690 items_per_second=123.072M/s
+BM_SparseTable_Query/4194304/64           856832 ns       846680 ns          684 items_per_second=77.4035M/s
+BM_BlockSparseTable_Query/16384/0         523059 ns       518929 ns         1395 items_per_second=126.291M/s
+BM_BlockSparseTable_Query/262144/0       1334518 ns      1319644 ns          470 items_per_second=49.6619M/s
+BM_BlockSparseTable_Query/4194304/0      2123427 ns      2104890 ns          335 items_per_second=31.1351M/s
+BM_BlockSparseTable_Query/67108864/0     5710514 ns      5691948 ns          103 items_per_second=11.5138M/s
+BM_BlockSparseTable_Query/16384/64        552050 ns       531652 ns         1584 items_per_second=123.269M/s
+BM_BlockSparseTable_Query/262144/64       829731 ns       822581 ns         1041 items_per_second=79.6711M/s
+BM_BlockSparseTable_Query/4194304/64     1691742 ns      1675088 ns          447 items_per_second=39.1239M/s
+BM_BlockSparseTable_Query/67108864/64    2904315 ns      2874890 ns          220 items_per_second=22.796M/s
+
+*/
@@ -1,105 +1,12 @@
 #include <cassert>
 #include <memory>
+#include <random>
+#include <set>
 #include <string>
 #include <vector>
 using namespace std;
 
-class Trie { // unique_ptr
-    struct TrieNode {
-        constexpr static size_t max_size = 'z' - 'a' + 1;
-        unique_ptr<TrieNode> next[max_size];
-        bool is_word;
-        TrieNode(bool is_word = false): is_word(is_word) {}
-    };
-
-    TrieNode root_;
-
-    TrieNode *Find(const string &s) {
-        TrieNode *p = &root_;
-        for(size_t i = 0; i < s.size() && p != nullptr; ++i)
-            p = p->next[s[i] - 'a'].get();
-        return p;
-    }
-
-public:
-    Trie() {}
-
-    // Inserts a word into the trie.
-    void Insert(const string &s) {
-        TrieNode *p = &root_;
-        for(size_t i = 0; i < s.size(); ++i) {
-            size_t k = s[i] - 'a';
-            if(p->next[k] == nullptr)
-                p->next[k] = make_unique<TrieNode>();
-            p = p->next[k].get();
-        }
-        p->is_word = true;
-    }
-
-    // Returns if the word is in the trie.
-    bool Search(const string &s) {
-        TrieNode *p = Find(s);
-        return p != nullptr && p->is_word;
-    }
-
-    // Returns if there is any word in the trie that starts with the given prefix.
-    bool StartsWith(const string &s) {
-        return Find(s) != nullptr;
-    }
-};
-
-/*
-class Trie { // manual memory management
-    struct TrieNode {
-        constexpr static size_t max_size = 'z' - 'a' + 1;
-        TrieNode *next[max_size]{};
-        bool is_word;
-        TrieNode(bool is_word = false) : is_word(is_word) {}
-    };
-
-    vector<TrieNode *> nodes_;
-    TrieNode root_;
-
-    TrieNode *Find(const string &s) {
-        TrieNode *p = &root_;
-        for(size_t i = 0; i < s.size() && p != nullptr; ++i)
-            p = p->next[s[i] - 'a'];
-        return p;
-    }
-
-public:
-    Trie() {}
-    ~Trie() {
-        for(auto node: nodes_)
-            delete node;
-    }
-
-    // Inserts a word into the trie.
-    void Insert(const string &s) {
-        TrieNode *p = &root_;
-        for(size_t i = 0; i < s.size(); ++i) {
-            size_t k = s[i] - 'a';
-            if(p->next[k] == nullptr) {
-                nodes_.push_back(new TrieNode);
-                p->next[k] = nodes_.back();
-            }
-            p = p->next[k];
-        }
-        p->is_word = true;
-    }
-
-    // Returns if the word is in the trie.
-    bool Search(const string &s) {
-        TrieNode *p = Find(s);
-        return p != nullptr && p->is_word;
-    }
-
-    // Returns if there is any word in the trie that starts with the given prefix.
-    bool StartsWith(const string &s) {
-        return Find(s) != nullptr;
-    }
-};
-*/
+#include "trie.hpp"
 
 int main() {
     Trie trie;
@@ -118,4 +25,81 @@ int main() {
 
     assert(trie.StartsWith("bcd") == false);
     assert(trie.StartsWith("xyz") == false);
+
+    {
+        CompactTrie trie;
+
+        trie.Insert("abcd");
+        trie.Insert("abxy");
+        trie.Insert("ab");
+        trie.Insert(string("\0\xff", 2)); // Any bytes.
+
+        assert(trie.Search("abcd") == true);
+        assert(trie.Search("ab") == true);
+        assert(trie.Search("abc") == false);
+        assert(trie.Search("a") == false);
+        assert(trie.Search("abcde") == false);
+        assert(trie.Search(string("\0\xff", 2)) == true);
+        assert(trie.Search(string("\0", 1)) == false);
+
+        assert(trie.StartsWith("abc") == true);
+        assert(trie.StartsWith("abx") == true);
+        assert(trie.StartsWith("abz") == false);
+        assert(trie.StartsWith(string("\0", 1)) == true);
+
+        vector<string> keys;
+        trie.ForEachWithPrefix("a", [&](const string &key) {
+            keys.push_back(key);
+        });
+        assert(keys == vector<string>({"ab", "abcd", "abxy"}));
+        keys.clear();
+        trie.ForEachWithPrefix("abc", [&](const string &key) {
+            keys.push_back(key);
+        });
+        assert(keys == vector<string>({"abcd"}));
+        assert(trie.size() == 4);
+    }
+
+    // Random keys over a small alphabet with many shared prefixes, and any bytes, against a set.
+    mt19937 gen(0);
+    for(int t = 0; t < 100; t++) {
+        int alphabet = t % 2 ? 3 : 256;
+        auto random_key = [&]() {
+            string key(gen() % 8, 0);
+            for(char &c: key)
+                c = char(gen() % alphabet);
+            return key;
+        };
+        CompactTrie trie;
+        set<string> keys;
+        for(int i = 0; i < 300; i++) {
+            string key = random_key();
+            trie.Insert(key);
+            keys.insert(key);
+        }
+        assert(trie.size() == keys.size());
+        if(t % 4 < 2) {
+            trie.Compact();
+            for(const string &key: keys)
+                assert(trie.Search(key));
+            string key = random_key(); // Inserting still works after `Compact()`.
+            trie.Insert(key);
+            keys.insert(key);
+        }
+        for(int q = 0; q < 300; q++) {
+            string key = random_key();
+            assert(trie.Search(key) == keys.count(key));
+            auto it = keys.lower_bound(key);
+            bool starts_with = it != keys.end() && it->compare(0, key.size(), key) == 0;
+            assert(trie.StartsWith(key) == starts_with);
+
+            vector<string> expected, found;
+            for(; it != keys.end() && it->compare(0, key.size(), key) == 0; ++it)
+                expected.push_back(*it);
+            trie.ForEachWithPrefix(key, [&](const string &key) {
+                found.push_back(key);
+            });
+            assert(found == expected);
+        }
+    }
 }
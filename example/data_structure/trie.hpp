@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class Trie { // unique_ptr
+    friend class LoudsTrie;
+
+    struct TrieNode {
+        constexpr static size_t max_size = 'z' - 'a' + 1;
+        std::unique_ptr<TrieNode> next[max_size];
+        bool is_word;
+        TrieNode(bool is_word = false): is_word(is_word) {}
+    };
+
+    TrieNode root_;
+
+    TrieNode *Find(const std::string &s) {
+        TrieNode *p = &root_;
+        for(size_t i = 0; i < s.size() && p != nullptr; ++i)
+            p = p->next[s[i] - 'a'].get();
+        return p;
+    }
+
+public:
+    Trie() {}
+
+    // Inserts a word into the trie.
+    void Insert(const std::string &s) {
+        TrieNode *p = &root_;
+        for(size_t i = 0; i < s.size(); ++i) {
+            size_t k = s[i] - 'a';
+            if(p->next[k] == nullptr)
+                p->next[k] = std::make_unique<TrieNode>();
+            p = p->next[k].get();
+        }
+        p->is_word = true;
+    }
+
+    // Returns if the word is in the trie.
+    bool Search(const std::string &s) {
+        TrieNode *p = Find(s);
+        return p != nullptr && p->is_word;
+    }
+
+    // Returns if there is any word in the trie that starts with the given prefix.
+    bool StartsWith(const std::string &s) {
+        return Find(s) != nullptr;
+    }
+};
+
+/*
+class Trie { // manual memory management
+    struct TrieNode {
+        constexpr static size_t max_size = 'z' - 'a' + 1;
+        TrieNode *next[max_size]{};
+        bool is_word;
+        TrieNode(bool is_word = false) : is_word(is_word) {}
+    };
+
+    std::vector<TrieNode *> nodes_;
+    TrieNode root_;
+
+    TrieNode *Find(const std::string &s) {
+        TrieNode *p = &root_;
+        for(size_t i = 0; i < s.size() && p != nullptr; ++i)
+            p = p->next[s[i] - 'a'];
+        return p;
+    }
+
+public:
+    Trie() {}
+    ~Trie() {
+        for(auto node: nodes_)
+            delete node;
+    }
+
+    // Inserts a word into the trie.
+    void Insert(const std::string &s) {
+        TrieNode *p = &root_;
+        for(size_t i = 0; i < s.size(); ++i) {
+            size_t k = s[i] - 'a';
+            if(p->next[k] == nullptr) {
+                nodes_.push_back(new TrieNode);
+                p->next[k] = nodes_.back();
+            }
+            p = p->next[k];
+        }
+        p->is_word = true;
+    }
+
+    // Returns if the word is in the trie.
+    bool Search(const std::string &s) {
+        TrieNode *p = Find(s);
+        return p != nullptr && p->is_word;
+    }
+
+    // Returns if there is any word in the trie that starts with the given prefix.
+    bool StartsWith(const std::string &s) {
+        return Find(s) != nullptr;
+    }
+};
+*/
+
+// A compact trie on arbitrary bytes, for many long keys with shared prefixes such as URLs.
+// Chains of single-child nodes are merged into one node whose edge label is a run of bytes
+// (a radix tree), so a key usually adds at most two nodes. Labels live in one byte arena and nodes
+// in another, linked by 32-bit indexes as first child and next sibling, 16 bytes per node.
+// Siblings are sorted by the first byte of their labels, so enumeration is in lexicographic order
+// of unsigned bytes.
+// Both arenas are indexed by 32 bits, so labels are limited to 4 GiB in total.
+class CompactTrie {
+    static constexpr uint32_t none = -1;
+    static constexpr uint32_t max_length = (1 << 23) - 1;
+
+    struct Node {
+        uint32_t label; // Offset of the edge label in `bytes_`.
+        uint32_t first : 8; // First byte of the label, to skip siblings without reading `bytes_`.
+        uint32_t is_word : 1;
+        uint32_t length : 23; // Of the label.
+        uint32_t child;
+        uint32_t sibling;
+    };
+
+    std::vector<Node> nodes_;
+    std::string bytes_;
+    size_t size_ = 0;
+
+    std::string_view Label(const Node &node) const {
+        return std::string_view(bytes_).substr(node.label, node.length);
+    }
+    // The child of `k` whose label starts with `byte`, or `none`. `prev` is the sibling before the
+    // place where it would be, or `none` if that's the first place.
+    uint32_t Child(uint32_t k, uint8_t byte, uint32_t &prev) const {
+        prev = none;
+        for(uint32_t c = nodes_[k].child; c != none; c = nodes_[c].sibling) {
+            if(nodes_[c].first == byte)
+                return c;
+            if(nodes_[c].first > byte)
+                break;
+            prev = c;
+        }
+        return none;
+    }
+    uint32_t NewNode(uint32_t label, uint32_t length) {
+        nodes_.push_back({label, uint8_t(bytes_[label]), 0, length, none, none});
+        return nodes_.size() - 1;
+    }
+    // Append nodes for `suffix` below `k`, after its child `prev`, return the last one.
+    uint32_t AddSuffix(uint32_t k, uint32_t prev, std::string_view suffix) {
+        size_t offset = bytes_.size();
+        bytes_.append(suffix);
+        while(!suffix.empty()) {
+            uint32_t length = suffix.size() < max_length ? suffix.size() : max_length;
+            uint32_t c = NewNode(offset, length);
+            if(prev == none) {
+                nodes_[c].sibling = nodes_[k].child;
+                nodes_[k].child = c;
+            } else {
+                nodes_[c].sibling = nodes_[prev].sibling;
+                nodes_[prev].sibling = c;
+            }
+            k = c;
+            prev = none;
+            offset += length;
+            suffix.remove_prefix(length);
+        }
+        return k;
+    }
+    // Split the label of `k` after `m` bytes, the rest going to a new child.
+    void Split(uint32_t k, uint32_t m) {
+        uint32_t tail = NewNode(nodes_[k].label + m, nodes_[k].length - m);
+        nodes_[tail].is_word = nodes_[k].is_word;
+        nodes_[tail].child = nodes_[k].child;
+        nodes_[k].length = m;
+        nodes_[k].is_word = 0;
+        nodes_[k].child = tail;
+    }
+    // The node where `s` ends, and how many bytes of its label are past the end, or `none`.
+    uint32_t Find(std::string_view s, uint32_t &rest) const {
+        uint32_t k = 0, prev;
+        rest = 0;
+        while(!s.empty()) {
+            k = Child(k, uint8_t(s[0]), prev);
+            if(k == none)
+                return none;
+            std::string_view label = Label(nodes_[k]);
+            size_t m = label.size() < s.size() ? label.size() : s.size();
+            if(label.compare(0, m, s, 0, m) != 0)
+                return none;
+            rest = label.size() - m;
+            s.remove_prefix(m);
+        }
+        return k;
+    }
+
+public:
+    CompactTrie() {
+        nodes_.push_back({0, 0, 0, 0, none, none});
+    }
+
+    // Inserts a word into the trie.
+    void Insert(std::string_view s) {
+        uint32_t k = 0, prev;
+        while(!s.empty()) {
+            uint32_t c = Child(k, uint8_t(s[0]), prev);
+            if(c == none) {
+                k = AddSuffix(k, prev, s);
+                break;
+            }
+            std::string_view label = Label(nodes_[c]);
+            uint32_t m = 1;
+            while(m < label.size() && m < s.size() && label[m] == s[m])
+                m++;
+            if(m < label.size())
+                Split(c, m);
+            k = c;
+            s.remove_prefix(m);
+        }
+        if(!nodes_[k].is_word) {
+            nodes_[k].is_word = 1;
+            size_++;
+        }
+    }
+
+    // Returns if the word is in the trie.
+    bool Search(std::string_view s) const {
+        uint32_t rest;
+        uint32_t k = Find(s, rest);
+        return k != none && rest == 0 && nodes_[k].is_word;
+    }
+
+    // Returns if there is any word in the trie that starts with the given prefix.
+    bool StartsWith(std::string_view s) const {
+        uint32_t rest;
+        return Find(s, rest) != none;
+    }
+
+    // Call `visitor(key)` for each word starting with `prefix`, in lexicographic order, without
+    // collecting them first. `key` is valid only during the call.
+    template<class Visitor>
+    void ForEachWithPrefix(std::string_view prefix, Visitor &&visitor) const {
+        uint32_t rest;
+        uint32_t k = Find(prefix, rest);
+        if(k == none)
+            return;
+        std::string key(prefix);
+        key.append(Label(nodes_[k]).substr(nodes_[k].length - rest));
+        if(nodes_[k].is_word)
+            visitor(key);
+        // Nodes to visit, with the length of the key above them.
+        std::vector<std::pair<uint32_t, size_t>> stack;
+        if(nodes_[k].child != none)
+            stack.push_back({nodes_[k].child, key.size()});
+        while(!stack.empty()) {
+            auto [c, depth] = stack.back();
+            stack.pop_back();
+            if(nodes_[c].sibling != none)
+                stack.push_back({nodes_[c].sibling, depth});
+            key.resize(depth);
+            key.append(Label(nodes_[c]));
+            if(nodes_[c].is_word)
+                visitor(key);
+            if(nodes_[c].child != none)
+                stack.push_back({nodes_[c].child, key.size()});
+        }
+    }
+
+    // Lay the nodes and labels out again in breadth-first order, so that the siblings a lookup goes
+    // through are adjacent and the labels of a level are close, e.g. after loading all the keys.
+    // Inserting afterwards is still fine, the new nodes just go to the end again.
+    void Compact() {
+        std::vector<uint32_t> order{0}; // Old indexes in the new order.
+        for(size_t i = 0; i < order.size(); i++)
+            for(uint32_t c = nodes_[order[i]].child; c != none; c = nodes_[c].sibling)
+                order.push_back(c);
+        std::vector<uint32_t> index(nodes_.size());
+        for(uint32_t i = 0; i < order.size(); i++)
+            index[order[i]] = i;
+        std::vector<Node> nodes;
+        std::string bytes;
+        nodes.reserve(nodes_.size());
+        bytes.reserve(bytes_.size());
+        for(uint32_t k: order) {
+            Node node = nodes_[k];
+            node.label = bytes.size();
+            bytes.append(Label(nodes_[k]));
+            node.child = node.child == none ? none : index[node.child];
+            node.sibling = node.sibling == none ? none : index[node.sibling];
+            nodes.push_back(node);
+        }
+        nodes_.swap(nodes);
+        bytes_.swap(bytes);
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    // Memory in use, including unused capacity.
+    size_t bytes() const {
+        return nodes_.capacity() * sizeof(Node) + bytes_.capacity();
+    }
+};
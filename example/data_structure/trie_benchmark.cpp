@@ -0,0 +1,151 @@
+// `CompactTrie` against `Trie` on URL-like keys: memory per key, build time and lookup latency.
+// Keys are lowercase only, which is all that `Trie` takes.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "benchmark/benchmark.h"
+
+#include "trie.hpp"
+#include "trie_keys.hpp"
+
+/*------------------------------------------------------------------------------------------------*/
+// Data.
+
+// Bytes of `Trie` on `keys`: one node per distinct prefix, the empty one included, each with 26
+// pointers and `is_word`, not counting the allocator's own overhead.
+size_t TrieBytes(vector<string> keys) {
+    sort(keys.begin(), keys.end());
+    size_t nodes = 1;
+    for(size_t i = 0; i < keys.size(); i++) {
+        size_t common = 0;
+        if(i)
+            while(common < keys[i].size() && common < keys[i - 1].size()
+                  && keys[i][common] == keys[i - 1][common])
+                common++;
+        nodes += keys[i].size() - common;
+    }
+    return nodes * (26 + 1) * sizeof(void *);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` keys. Items are keys.
+
+static void BM_Trie_Build(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    for(auto _: state) {
+        auto trie = make_unique<Trie>();
+        for(const string &key: keys)
+            trie->Insert(key);
+        benchmark::DoNotOptimize(trie);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    state.counters["bytes_per_key"] = double(TrieBytes(keys)) / keys.size();
+}
+BENCHMARK(BM_Trie_Build)->RangeMultiplier(16)->Range(1 << 12, 1 << 16);
+
+static void BM_CompactTrie_Build(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    size_t bytes = 0;
+    for(auto _: state) {
+        CompactTrie trie;
+        for(const string &key: keys)
+            trie.Insert(key);
+        bytes = trie.bytes();
+        benchmark::DoNotOptimize(trie);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    state.counters["bytes_per_key"] = double(bytes) / keys.size();
+}
+BENCHMARK(BM_CompactTrie_Build)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// `state.range(0)` keys, looked up in random order, half of them missing by their last byte.
+// Items are lookups.
+
+static void BM_Trie_Search(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    vector<string> misses = Misses(keys);
+    Trie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    for(auto _: state)
+        for(size_t i = 0; i < keys.size(); i++)
+            benchmark::DoNotOptimize(trie.Search(i % 2 ? misses[i] : keys[i]));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Trie_Search)->RangeMultiplier(16)->Range(1 << 12, 1 << 16);
+
+static void BM_CompactTrie_Search(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    vector<string> misses = Misses(keys);
+    CompactTrie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    if(state.range(1))
+        trie.Compact();
+    for(auto _: state)
+        for(size_t i = 0; i < keys.size(); i++)
+            benchmark::DoNotOptimize(trie.Search(i % 2 ? misses[i] : keys[i]));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+// `state.range(1)` is whether `Compact()` was called.
+BENCHMARK(BM_CompactTrie_Search)->ArgsProduct({{1 << 12, 1 << 16, 1 << 20}, {0, 1}});
+
+/*------------------------------------------------------------------------------------------------*/
+// `ForEachWithPrefix()` with the host part of random keys as prefixes. Items are keys visited.
+
+static void BM_CompactTrie_ForEachWithPrefix(benchmark::State &state) {
+    const vector<string> &keys = Keys(state.range(0));
+    CompactTrie trie;
+    for(const string &key: keys)
+        trie.Insert(key);
+    trie.Compact();
+    vector<string> prefixes;
+    for(size_t i = 0; i < 1024; i++) {
+        const string &key = keys[i * 7919 % keys.size()];
+        prefixes.push_back(key.substr(0, key.find("com") + 3));
+    }
+    size_t visited = 0;
+    for(auto _: state)
+        for(const string &prefix: prefixes)
+            trie.ForEachWithPrefix(prefix, [&](const string &key) {
+                benchmark::DoNotOptimize(key.data());
+                visited++;
+            });
+    state.SetItemsProcessed(visited);
+}
+BENCHMARK(BM_CompactTrie_ForEachWithPrefix)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`.
+
+Run on (1 X 2100 MHz CPU s)
+---------------------------------------------------------------------------------------------------
+Benchmark                                         Time             CPU   Iterations UserCounters...
+---------------------------------------------------------------------------------------------------
+BM_Trie_Build/4096                         14486862 ns     13659891 ns           55 bytes_per_key=3.07932k items_per_second=299.856k/s
+BM_Trie_Build/65536                       350713622 ns    342400892 ns            2 bytes_per_key=3.11574k items_per_second=191.401k/s
+BM_CompactTrie_Build/4096                    914425 ns       889097 ns          780 bytes_per_key=60 items_per_second=4.60692M/s
+BM_CompactTrie_Build/65536                 32035384 ns     31323261 ns           31 bytes_per_key=52 items_per_second=2.09225M/s
+BM_CompactTrie_Build/1048576             2234910134 ns   2204605069 ns            1 bytes_per_key=58.5 items_per_second=475.63k/s
+BM_Trie_Search/4096                         2267193 ns      2204390 ns          355 items_per_second=1.85811M/s
+BM_Trie_Search/65536                      149995697 ns    141772208 ns            5 items_per_second=462.263k/s
+BM_CompactTrie_Search/4096/0                 965975 ns       947249 ns          874 items_per_second=4.3241M/s
+BM_CompactTrie_Search/65536/0              58991354 ns     56329165 ns           11 items_per_second=1.16345M/s
+BM_CompactTrie_Search/1048576/0          3131968769 ns   3074332881 ns            1 items_per_second=341.074k/s
+BM_CompactTrie_Search/4096/1                 856192 ns       841531 ns          838 items_per_second=4.86732M/s
+BM_CompactTrie_Search/65536/1              32115679 ns     31744842 ns           21 items_per_second=2.06446M/s
+BM_CompactTrie_Search/1048576/1          1597644916 ns   1579898305 ns            1 items_per_second=663.698k/s
+BM_CompactTrie_ForEachWithPrefix/4096       2762746 ns      2713573 ns          276 items_per_second=24.565M/s
+BM_CompactTrie_ForEachWithPrefix/65536      3396307 ns      3313500 ns          205 items_per_second=20.0401M/s
+BM_CompactTrie_ForEachWithPrefix/1048576    3981471 ns      3908519 ns          165 items_per_second=17.193M/s
+*/
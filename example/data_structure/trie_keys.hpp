@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// URL-like keys for `trie_benchmark.cpp` and `louds_trie_benchmark.cpp`, so that both run on the
+// same keys. Lowercase only, which is all that `Trie` takes.
+
+inline std::string Word(std::mt19937 &gen) {
+    std::string word(gen() % 7 + 3, 0);
+    for(char &c: word)
+        c = 'a' + gen() % 26;
+    return word;
+}
+
+// `n` distinct keys like "httpswww<host>com<path>", with hosts and path segments drawn from small
+// vocabularies, in random order.
+inline const std::vector<std::string> &Keys(int n) {
+    static std::map<int, std::vector<std::string>> cache;
+    auto it = cache.find(n);
+    if(it == cache.end()) {
+        std::mt19937 gen(0);
+        std::vector<std::string> hosts(std::max(n / 64, 1)), segments(1000);
+        for(auto &host: hosts)
+            host = Word(gen) + Word(gen);
+        for(auto &segment: segments)
+            segment = Word(gen);
+        std::vector<std::string> keys;
+        while(int(keys.size()) < n) {
+            std::string key = "httpswww" + hosts[gen() % hosts.size()] + "com";
+            for(int i = gen() % 4 + 1; i > 0; i--)
+                key += segments[gen() % segments.size()];
+            keys.push_back(key);
+            if(int(keys.size()) == n) {
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            }
+        }
+        std::shuffle(keys.begin(), keys.end(), gen);
+        it = cache.emplace(n, std::move(keys)).first;
+    }
+    return it->second;
+}
+
+// For each of `keys`, a key that isn't in `keys`, with the same prefix: the last letter is changed
+// to the next one, wrapping around, that doesn't make another key.
+inline std::vector<std::string> Misses(const std::vector<std::string> &keys) {
+    std::unordered_set<std::string> present(keys.begin(), keys.end());
+    std::vector<std::string> misses;
+    for(std::string key: keys) {
+        char last = key.back();
+        do {
+            key.back() = key.back() == 'z' ? 'a' : key.back() + 1;
+        } while(present.count(key) && key.back() != last);
+        misses.push_back(key);
+    }
+    return misses;
+}
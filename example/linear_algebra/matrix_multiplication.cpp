@@ -1,181 +1,442 @@
+// Matrix multiplication, C = A B, by Armadillo, Eigen, manual loops and `Sgemm()` in float,
+// double and half precision, on square matrices of N = 64..4096, square matrices with transposed
+// operands, tall-skinny matrices, and batches of small matrices. Each variant is checked against a
+// double precision reference before it's timed, and skipped with an error if it's wrong.
+// Counters are FLOP/s, 2 m n k per product, and bytes/s of A and B read and C written once.
+// The Armadillo benchmarks are left out where it isn't installed.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+using namespace std;
+
+#if __has_include(<armadillo>)
 #include <armadillo>
-using namespace arma;
+#define HAS_ARMADILLO
+#endif
 
 #include <Eigen/Core>
 using namespace Eigen;
 
 #include "benchmark/benchmark.h"
 
+#include "sgemm.hpp"
+
 /*------------------------------------------------------------------------------------------------*/
 // Data.
 
-constexpr int N = 128;
+// Machine epsilon. Eigen 3.3 has 2^-13 for `half`, rather than 2^-10.
+template<typename T>
+double Epsilon() {
+    return numeric_limits<T>::epsilon();
+}
+template<>
+double Epsilon<half>() {
+    return 1.0 / 1024;
+}
 
-fmat::fixed<N, N> m0_arma = randu<fmat>(N, N);
-fmat::fixed<N, N> m1_arma = randu<fmat>(N, N);
-fmat::fixed<N, N> m2_arma = zeros<fmat>(N, N);
+// `batch` products of row-major m x k A and k x n B into m x n C, each after the other in memory.
+// With `trans_a`, A is stored as its k x m transpose, and with `trans_b`, B as its n x k one.
+template<typename T>
+struct Products {
+    int m, n, k, batch;
+    bool trans_a, trans_b;
+    vector<T> a, b, c;
 
-Matrix<float, N, N> m0_eigen(m0_arma.mem);
-Matrix<float, N, N> m1_eigen(m1_arma.mem);
-Matrix<float, N, N> m2_eigen = MatrixXf::Zero(N, N);
+    Products(int m, int n, int k, int batch, bool trans_a = false, bool trans_b = false)
+        : m(m), n(n), k(k), batch(batch), trans_a(trans_a), trans_b(trans_b),
+          a(size_t(m) * k * batch), b(size_t(k) * n * batch), c(size_t(m) * n * batch) {
+        mt19937 gen(m + n + k);
+        uniform_real_distribution<float> dist(-1, 1);
+        for(T &x: a)
+            x = T(dist(gen));
+        for(T &x: b)
+            x = T(dist(gen));
+    }
 
-float m0_manual[N][N];
-float m1_manual[N][N];
-float m2_manual[N][N];
+    template<typename Gemm>
+    void Run(Gemm &gemm) {
+        for(int i = 0; i < batch; i++)
+            gemm(m, n, k, &a[size_t(m) * k * i], &b[size_t(k) * n * i], &c[size_t(m) * n * i]);
+    }
+
+    // Check C against dot products in double precision, all of it if it's small, else 4096
+    // random elements. A dot product of length k may be off by k epsilons of the sum of the
+    // absolute values of the terms in the worst case, but rounding errors of random terms mostly
+    // cancel out, to about sqrt(k) epsilons, which catches more mistakes. Plus the subnormals lost
+    // if it underflows.
+    bool Verify() const {
+        double epsilon = Epsilon<T>();
+        double subnormal = static_cast<double>(numeric_limits<T>::denorm_min());
+        auto check = [&](int p, int i, int j) {
+            const T *a_p = &a[size_t(m) * k * p], *b_p = &b[size_t(k) * n * p];
+            double sum = 0, sum_abs = 0;
+            for(int l = 0; l < k; l++) {
+                double a_il = static_cast<double>(trans_a ? a_p[l * m + i] : a_p[i * k + l]);
+                double x = a_il * static_cast<double>(trans_b ? b_p[j * k + l] : b_p[l * n + j]);
+                sum += x;
+                sum_abs += fabs(x);
+            }
+            double c_ij = static_cast<double>(c[size_t(m) * n * p + i * n + j]);
+            return fabs(c_ij - sum) <= 4 * sqrt(k + 2.0) * epsilon * sum_abs + k * subnormal;
+        };
+        if(double(m) * n * k * batch <= 1 << 24) {
+            for(int p = 0; p < batch; p++)
+                for(int i = 0; i < m; i++)
+                    for(int j = 0; j < n; j++)
+                        if(!check(p, i, j))
+                            return false;
+            return true;
+        }
+        mt19937 gen(0);
+        for(int t = 0; t < 4096; t++)
+            if(!check(gen() % batch, gen() % m, gen() % n))
+                return false;
+        return true;
+    }
+};
 
 /*------------------------------------------------------------------------------------------------*/
-// Armadillo.
+// Variants. Each computes one product of row-major matrices, `gemm(m, n, k, a, b, c)`.
+
+// With `trans_a` or `trans_b`, like `Products`, the operand is transposed in the expression.
+struct EigenGemm {
+    bool trans_a = false, trans_b = false;
+
+    template<typename T>
+    void operator()(int m, int n, int k, const T *a, const T *b, T *c) const {
+        using RowMajorMatrix = Matrix<T, Dynamic, Dynamic, RowMajor>;
+        Map<const RowMajorMatrix> a_map(a, trans_a ? k : m, trans_a ? m : k);
+        Map<const RowMajorMatrix> b_map(b, trans_b ? n : k, trans_b ? k : n);
+        Map<RowMajorMatrix> c_map(c, m, n);
+        if(trans_a && trans_b)
+            c_map.noalias() = a_map.transpose() * b_map.transpose();
+        else if(trans_a)
+            c_map.noalias() = a_map.transpose() * b_map;
+        else if(trans_b)
+            c_map.noalias() = a_map * b_map.transpose();
+        else
+            c_map.noalias() = a_map * b_map;
+    }
+};
+
+// The textbook loop order, with B read by column.
+struct ManualIJKGemm {
+    template<typename T>
+    void operator()(int m, int n, int k, const T *a, const T *b, T *c) const {
+        for(int i = 0; i < m; i++)
+            for(int j = 0; j < n; j++) {
+                T sum = T(0);
+                for(int l = 0; l < k; l++)
+                    sum += a[i * k + l] * b[l * n + j];
+                c[i * n + j] = sum;
+            }
+    }
+};
+
+// B read by row, which the compiler vectorizes.
+struct ManualIKJGemm {
+    template<typename T>
+    void operator()(int m, int n, int k, const T *a, const T *b, T *c) const {
+        fill(c, c + size_t(m) * n, T(0));
+        for(int i = 0; i < m; i++)
+            for(int l = 0; l < k; l++) {
+                T a_il = a[i * k + l];
+                for(int j = 0; j < n; j++)
+                    c[i * n + j] += a_il * b[l * n + j];
+            }
+    }
+};
+
+struct SgemmGemm {
+    void operator()(int m, int n, int k, const float *a, const float *b, float *c) const {
+        Sgemm(m, n, k, a, k, b, n, c, n);
+    }
+};
 
-static void BM_MatMul_Arma_0(benchmark::State &state) {
-    for(auto _: state)
-        m2_arma = m0_arma * m1_arma;
+// On all hardware threads.
+struct ParallelSgemmGemm {
+    void operator()(int m, int n, int k, const float *a, const float *b, float *c) const {
+        static ThreadPool pool;
+        ParallelSgemm(m, n, k, a, k, b, n, c, n, pool);
+    }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+// Shapes. The element type is passed as a value, e.g. `float()`, to pick the template.
+
+template<typename T, typename Gemm>
+void Run(benchmark::State &state, Gemm gemm, int m, int n, int k, int batch, bool trans_a = false,
+         bool trans_b = false) {
+    Products<T> products(m, n, k, batch, trans_a, trans_b);
+    products.Run(gemm);
+    if(!products.Verify()) {
+        state.SkipWithError("Wrong result");
+        return;
+    }
+    for(auto _: state) {
+        products.Run(gemm);
+        benchmark::DoNotOptimize(products.c.data());
+    }
+    double flops = 2.0 * m * n * k * batch;
+    double bytes = (double(m) * k + double(k) * n + double(m) * n) * batch * sizeof(T);
+    using benchmark::Counter;
+    state.counters["FLOP/s"] = Counter(flops, Counter::kIsIterationInvariantRate);
+    state.counters["bytes/s"] =
+        Counter(bytes, Counter::kIsIterationInvariantRate, Counter::kIs1024);
 }
-BENCHMARK(BM_MatMul_Arma_0);
 
-static void BM_MatMul_Arma_1(benchmark::State &state) {
-    for(auto _: state)
-        m2_arma = m0_arma.t() * m1_arma;
+// `state.range(0)` is N.
+template<typename Gemm, typename T>
+static void BM_Square(benchmark::State &state, Gemm gemm, T) {
+    int n = state.range(0);
+    Run<T>(state, gemm, n, n, n, 1);
 }
-BENCHMARK(BM_MatMul_Arma_1);
 
-static void BM_MatMul_Arma_2(benchmark::State &state) {
-    for(auto _: state)
-        m2_arma = m0_arma * m1_arma.t();
+// `state.range(0)` is N, and `state.range(1)` which operands are stored transposed: 0 for A B,
+// 1 for A^T B, 2 for A B^T and 3 for A^T B^T.
+template<typename Gemm, typename T>
+static void BM_Transposed(benchmark::State &state, Gemm, T) {
+    int n = state.range(0);
+    bool trans_a = state.range(1) & 1, trans_b = state.range(1) & 2;
+    Run<T>(state, Gemm{trans_a, trans_b}, n, n, n, 1, trans_a, trans_b);
 }
-BENCHMARK(BM_MatMul_Arma_2);
 
-static void BM_MatMul_Arma_3(benchmark::State &state) {
-    for(auto _: state)
-        m2_arma = m0_arma.t() * m1_arma.t();
+// `state.range()` is m, n and k. A m x k with m >> k, or k >> m, n.
+template<typename Gemm, typename T>
+static void BM_TallSkinny(benchmark::State &state, Gemm gemm, T) {
+    Run<T>(state, gemm, state.range(0), state.range(1), state.range(2), 1);
 }
-BENCHMARK(BM_MatMul_Arma_3);
 
-/*------------------------------------------------------------------------------------------------*/
-// Eigen.
+// `state.range()` is N, and the number of N x N products, for 2^20 elements in each operand.
+template<typename Gemm, typename T>
+static void BM_Batched(benchmark::State &state, Gemm gemm, T) {
+    int n = state.range(0);
+    Run<T>(state, gemm, n, n, n, state.range(1));
+}
 
-static void BM_MatMul_Eigen_0(benchmark::State &state) {
-    for(auto _: state)
-        m2_eigen = m0_eigen * m1_eigen;
+template<int max_n>
+void SquareSizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(2)->Range(64, max_n)->Unit(benchmark::kMicrosecond);
 }
-BENCHMARK(BM_MatMul_Eigen_0);
 
-static void BM_MatMul_Eigen_1(benchmark::State &state) {
-    for(auto _: state)
-        m2_eigen = m0_eigen.transpose() * m1_eigen;
+void TransposedSizes(benchmark::internal::Benchmark *b) {
+    for(int n: {128, 1024})
+        for(int transposed = 0; transposed < 4; transposed++)
+            b->Args({n, transposed});
+    b->Unit(benchmark::kMicrosecond);
 }
-BENCHMARK(BM_MatMul_Eigen_1);
 
-static void BM_MatMul_Eigen_2(benchmark::State &state) {
-    for(auto _: state)
-        m2_eigen = m0_eigen * m1_eigen.transpose();
+void TallSkinnySizes(benchmark::internal::Benchmark *b) {
+    b->Args({1 << 16, 32, 32})->Args({1 << 16, 128, 128})->Args({32, 32, 1 << 16});
+    b->Unit(benchmark::kMicrosecond);
 }
-BENCHMARK(BM_MatMul_Eigen_2);
 
-static void BM_MatMul_Eigen_3(benchmark::State &state) {
-    for(auto _: state)
-        m2_eigen = m0_eigen.transpose() * m1_eigen.transpose();
+void BatchedSizes(benchmark::internal::Benchmark *b) {
+    for(int n: {4, 8, 16, 32, 64})
+        b->Args({n, (1 << 20) / (n * n)});
+    b->Unit(benchmark::kMicrosecond);
 }
-BENCHMARK(BM_MatMul_Eigen_3);
 
 /*------------------------------------------------------------------------------------------------*/
-// Manual.
+// Square. Slow variants stop at smaller N.
 
-static void BM_MatMul_Manual_0(benchmark::State &state) {
-    for(auto _: state) {
-        for(int i_row = 0; i_row < N; ++i_row)
-            for(int i_col = 0; i_col < N; ++i_col)
-                for(int k = 0; k < N; ++k)
-                    m2_manual[i_row][i_col] += m0_manual[i_row][k] * m1_manual[k][i_col];
-    }
-}
-BENCHMARK(BM_MatMul_Manual_0);
+BENCHMARK_CAPTURE(BM_Square, Eigen_float, EigenGemm(), float())->Apply(SquareSizes<4096>);
+BENCHMARK_CAPTURE(BM_Square, ManualIJK_float, ManualIJKGemm(), float())->Apply(SquareSizes<512>);
+BENCHMARK_CAPTURE(BM_Square, ManualIKJ_float, ManualIKJGemm(), float())->Apply(SquareSizes<1024>);
+BENCHMARK_CAPTURE(BM_Square, Sgemm_float, SgemmGemm(), float())->Apply(SquareSizes<4096>);
+BENCHMARK_CAPTURE(BM_Square, ParallelSgemm_float, ParallelSgemmGemm(), float())
+    ->Apply(SquareSizes<4096>)
+    ->UseRealTime();
 
-static void BM_MatMul_Manual_1(benchmark::State &state) {
-    for(auto _: state) {
-        for(int i_row = 0; i_row < N; ++i_row)
-            for(int k = 0; k < N; ++k)
-                for(int i_col = 0; i_col < N; ++i_col)
-                    m2_manual[i_row][i_col] += m0_manual[i_row][k] * m1_manual[k][i_col];
-    }
-}
-BENCHMARK(BM_MatMul_Manual_1);
+BENCHMARK_CAPTURE(BM_Square, Eigen_double, EigenGemm(), double())->Apply(SquareSizes<2048>);
+BENCHMARK_CAPTURE(BM_Square, ManualIKJ_double, ManualIKJGemm(), double())->Apply(SquareSizes<1024>);
 
-static void BM_MatMul_Manual_2(benchmark::State &state) {
-    for(auto _: state) {
-        for(int i_row = 0; i_row < N; ++i_row)
-            for(int k = 0; k < N; ++k) {
-                float e_m0_manual = m0_manual[i_row][k];
-                for(int i_col = 0; i_col < N; ++i_col)
-                    m2_manual[i_row][i_col] += e_m0_manual * m1_manual[k][i_col];
-            }
-    }
-}
-BENCHMARK(BM_MatMul_Manual_2);
+// Armadillo has no half precision, and x86 computes it in float, element by element.
+BENCHMARK_CAPTURE(BM_Square, Eigen_half, EigenGemm(), half())->Apply(SquareSizes<512>);
+BENCHMARK_CAPTURE(BM_Square, ManualIKJ_half, ManualIKJGemm(), half())->Apply(SquareSizes<512>);
 
 /*------------------------------------------------------------------------------------------------*/
-// Init.
+// Transposed operands.
 
-// BENCHMARK_MAIN();
+BENCHMARK_CAPTURE(BM_Transposed, Eigen_float, EigenGemm(), float())->Apply(TransposedSizes);
+BENCHMARK_CAPTURE(BM_Transposed, Eigen_double, EigenGemm(), double())->Apply(TransposedSizes);
 
-int main(int argc, char *argv[]) {
-    memcpy(m0_manual, m0_arma.memptr(), N * N);
-    memcpy(m1_manual, m1_arma.memptr(), N * N);
-    memset(m2_manual, 0, N * N);
+/*------------------------------------------------------------------------------------------------*/
+// Tall-skinny.
 
-    ::benchmark::Initialize(&argc, argv);
-    ::benchmark::RunSpecifiedBenchmarks();
-}
+BENCHMARK_CAPTURE(BM_TallSkinny, Eigen_float, EigenGemm(), float())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, ManualIKJ_float, ManualIKJGemm(), float())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, Sgemm_float, SgemmGemm(), float())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, Eigen_double, EigenGemm(), double())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, Eigen_half, EigenGemm(), half())->Apply(TallSkinnySizes);
 
 /*------------------------------------------------------------------------------------------------*/
-/* Without -march=native.
-
-Run on (8 X 4200 MHz CPU s)
-CPU Caches:
-  L1 Data 32 KiB (x4)
-  L1 Instruction 32 KiB (x4)
-  L2 Unified 256 KiB (x4)
-  L3 Unified 8192 KiB (x1)
-Load Average: 3.17, 4.18, 3.95
--------------------------------------------------------------
-Benchmark                   Time             CPU   Iterations
--------------------------------------------------------------
-BM_MatMul_Arma_0        30479 ns        29104 ns        25940
-BM_MatMul_Arma_1        28009 ns        26815 ns        25558
-BM_MatMul_Arma_2        30502 ns        27851 ns        24467
-BM_MatMul_Arma_3        29801 ns        28225 ns        24515
-BM_MatMul_Eigen_0      142370 ns       141698 ns         4445
-BM_MatMul_Eigen_1      142383 ns       141653 ns         4964
-BM_MatMul_Eigen_2      144278 ns       143615 ns         4873
-BM_MatMul_Eigen_3      144265 ns       143760 ns         4879
-BM_MatMul_Manual_0    1612288 ns      1606306 ns          431
-BM_MatMul_Manual_1     158825 ns       158303 ns         4405
-BM_MatMul_Manual_2     159906 ns       159182 ns         4411
+// Batched small matrices.
 
-*/
+BENCHMARK_CAPTURE(BM_Batched, Eigen_float, EigenGemm(), float())->Apply(BatchedSizes);
+BENCHMARK_CAPTURE(BM_Batched, ManualIKJ_float, ManualIKJGemm(), float())->Apply(BatchedSizes);
+BENCHMARK_CAPTURE(BM_Batched, Sgemm_float, SgemmGemm(), float())->Apply(BatchedSizes);
+BENCHMARK_CAPTURE(BM_Batched, Eigen_double, EigenGemm(), double())->Apply(BatchedSizes);
+BENCHMARK_CAPTURE(BM_Batched, Eigen_half, EigenGemm(), half())->Apply(BatchedSizes);
 
 /*------------------------------------------------------------------------------------------------*/
-/* With -march=native.
-
-Run on (8 X 4200 MHz CPU s)
-CPU Caches:
-  L1 Data 32 KiB (x4)
-  L1 Instruction 32 KiB (x4)
-  L2 Unified 256 KiB (x4)
-  L3 Unified 8192 KiB (x1)
-Load Average: 2.64, 3.79, 3.88
--------------------------------------------------------------
-Benchmark                   Time             CPU   Iterations
--------------------------------------------------------------
-BM_MatMul_Arma_0        27628 ns        27323 ns        25432
-BM_MatMul_Arma_1        28800 ns        28415 ns        24107
-BM_MatMul_Arma_2        30992 ns        30443 ns        23324
-BM_MatMul_Arma_3        29571 ns        29180 ns        23135
-BM_MatMul_Eigen_0       50309 ns        50310 ns        13879
-BM_MatMul_Eigen_1       50713 ns        50714 ns        13759
-BM_MatMul_Eigen_2       54583 ns        54583 ns        12704
-BM_MatMul_Eigen_3       58892 ns        58891 ns        11828
-BM_MatMul_Manual_0    1597445 ns      1597476 ns          436
-BM_MatMul_Manual_1      73072 ns        73073 ns         9497
-BM_MatMul_Manual_2      73581 ns        73582 ns         9537
+// Armadillo.
+
+#ifdef HAS_ARMADILLO
+
+// Armadillo is column-major, and a row-major matrix is its transpose in column-major, so C = A B
+// is C^T = B^T A^T, on the same memory without copies. An operand stored transposed, like in
+// `Products`, is transposed back in the expression.
+struct ArmaGemm {
+    bool trans_a = false, trans_b = false;
+
+    template<typename T>
+    void operator()(int m, int n, int k, const T *a, const T *b, T *c) const {
+        const arma::Mat<T> a_t(const_cast<T *>(a), trans_a ? m : k, trans_a ? k : m, false, true);
+        const arma::Mat<T> b_t(const_cast<T *>(b), trans_b ? k : n, trans_b ? n : k, false, true);
+        arma::Mat<T> c_t(c, n, m, false, true);
+        if(trans_a && trans_b)
+            c_t = b_t.t() * a_t.t();
+        else if(trans_a)
+            c_t = b_t * a_t.t();
+        else if(trans_b)
+            c_t = b_t.t() * a_t;
+        else
+            c_t = b_t * a_t;
+    }
+};
+
+BENCHMARK_CAPTURE(BM_Square, Arma_float, ArmaGemm(), float())->Apply(SquareSizes<4096>);
+BENCHMARK_CAPTURE(BM_Square, Arma_double, ArmaGemm(), double())->Apply(SquareSizes<2048>);
+BENCHMARK_CAPTURE(BM_Transposed, Arma_float, ArmaGemm(), float())->Apply(TransposedSizes);
+BENCHMARK_CAPTURE(BM_Transposed, Arma_double, ArmaGemm(), double())->Apply(TransposedSizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, Arma_float, ArmaGemm(), float())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_TallSkinny, Arma_double, ArmaGemm(), double())->Apply(TallSkinnySizes);
+BENCHMARK_CAPTURE(BM_Batched, Arma_float, ArmaGemm(), float())->Apply(BatchedSizes);
+BENCHMARK_CAPTURE(BM_Batched, Arma_double, ArmaGemm(), double())->Apply(BatchedSizes);
+
+#endif
+
+/*------------------------------------------------------------------------------------------------*/
+// Init.
+
+BENCHMARK_MAIN();
+
+/*------------------------------------------------------------------------------------------------*/
+/* Release mode (`-O3`) with `-march=native`. Only one hardware thread on this machine, and no
+Armadillo, so no Armadillo benchmarks.
+
+Run on (1 X 2100 MHz CPU s)
+-------------------------------------------------------------------------------------------------------
+Benchmark                                             Time             CPU   Iterations UserCounters...
+-------------------------------------------------------------------------------------------------------
+BM_Square/Eigen_float/64                           6.55 us         6.44 us       111531 FLOP/s=81.4507G/s bytes/s=7.11158G/s
+BM_Square/Eigen_float/128                          42.4 us         41.7 us        16697 FLOP/s=100.555G/s bytes/s=4.38981G/s
+BM_Square/Eigen_float/256                           450 us          441 us         1615 FLOP/s=76.0151G/s bytes/s=1.65925G/s
+BM_Square/Eigen_float/512                          2778 us         2744 us          260 FLOP/s=97.823G/s bytes/s=1093.26M/s
+BM_Square/Eigen_float/1024                        23142 us        22623 us           31 FLOP/s=94.9255G/s bytes/s=530.438M/s
+BM_Square/Eigen_float/2048                       193798 us       190046 us            4 FLOP/s=90.3985G/s bytes/s=252.571M/s
+BM_Square/Eigen_float/4096                      1631420 us      1590029 us            1 FLOP/s=86.438G/s bytes/s=120.753M/s
+BM_Square/ManualIJK_float/64                        186 us          183 us         3393 FLOP/s=2.85765G/s bytes/s=255.494M/s
+BM_Square/ManualIJK_float/128                      2735 us         2684 us          256 FLOP/s=1.56289G/s bytes/s=69.8667M/s
+BM_Square/ManualIJK_float/256                     23506 us        23104 us           31 FLOP/s=1.45232G/s bytes/s=32.4618M/s
+BM_Square/ManualIJK_float/512                    175996 us       173678 us            4 FLOP/s=1.54559G/s bytes/s=17.2733M/s
+BM_Square/ManualIKJ_float/64                       33.1 us         32.5 us        21628 FLOP/s=16.1112G/s bytes/s=1.4067G/s
+BM_Square/ManualIKJ_float/128                       297 us          291 us         2350 FLOP/s=14.4268G/s bytes/s=644.926M/s
+BM_Square/ManualIKJ_float/256                      2157 us         2122 us          332 FLOP/s=15.8131G/s bytes/s=353.451M/s
+BM_Square/ManualIKJ_float/512                     16915 us        16608 us           43 FLOP/s=16.1629G/s bytes/s=180.635M/s
+BM_Square/ManualIKJ_float/1024                   198383 us       195505 us            4 FLOP/s=10.9843G/s bytes/s=61.3796M/s
+BM_Square/Sgemm_float/64                           8.71 us         8.16 us        91208 FLOP/s=64.2184G/s bytes/s=5.607G/s
+BM_Square/Sgemm_float/128                          59.1 us         58.4 us        13199 FLOP/s=71.8797G/s bytes/s=3.13796G/s
+BM_Square/Sgemm_float/256                           312 us          308 us         1626 FLOP/s=108.868G/s bytes/s=2.37635G/s
+BM_Square/Sgemm_float/512                          2595 us         2557 us          272 FLOP/s=104.992G/s bytes/s=1.14588G/s
+BM_Square/Sgemm_float/1024                        25010 us        24568 us           28 FLOP/s=87.4099G/s bytes/s=488.441M/s
+BM_Square/Sgemm_float/2048                       205396 us       201470 us            3 FLOP/s=85.2727G/s bytes/s=238.249M/s
+BM_Square/Sgemm_float/4096                      1738891 us      1709602 us            1 FLOP/s=80.3924G/s bytes/s=112.307M/s
+BM_Square/ParallelSgemm_float/64/real_time         9.15 us         8.99 us        80810 FLOP/s=57.3003G/s bytes/s=5.00298G/s
+BM_Square/ParallelSgemm_float/128/real_time        54.9 us         53.6 us        13043 FLOP/s=76.3977G/s bytes/s=3.3352G/s
+BM_Square/ParallelSgemm_float/256/real_time         441 us          412 us         1739 FLOP/s=76.1106G/s bytes/s=1.66133G/s
+BM_Square/ParallelSgemm_float/512/real_time        4215 us         3124 us          156 FLOP/s=63.6884G/s bytes/s=711.773M/s
+BM_Square/ParallelSgemm_float/1024/real_time      23295 us        22815 us           30 FLOP/s=92.1857G/s bytes/s=515.128M/s
+BM_Square/ParallelSgemm_float/2048/real_time     197702 us       194201 us            4 FLOP/s=86.898G/s bytes/s=242.79M/s
+BM_Square/ParallelSgemm_float/4096/real_time    1659117 us      1631789 us            1 FLOP/s=82.8386G/s bytes/s=115.724M/s
+BM_Square/Eigen_double/64                          14.4 us         14.1 us        49827 FLOP/s=37.2823G/s bytes/s=6.51035G/s
+BM_Square/Eigen_double/128                         94.8 us         93.1 us         7593 FLOP/s=45.0372G/s bytes/s=3.93227G/s
+BM_Square/Eigen_double/256                          792 us          773 us          923 FLOP/s=43.4012G/s bytes/s=1.89471G/s
+BM_Square/Eigen_double/512                         6101 us         6020 us          113 FLOP/s=44.5913G/s bytes/s=996.693M/s
+BM_Square/Eigen_double/1024                       53837 us        53115 us           13 FLOP/s=40.4309G/s bytes/s=451.851M/s
+BM_Square/Eigen_double/2048                      432395 us       425843 us            2 FLOP/s=40.3432G/s bytes/s=225.435M/s
+BM_Square/ManualIKJ_double/64                      48.8 us         47.4 us        13988 FLOP/s=11.0547G/s bytes/s=1.9304G/s
+BM_Square/ManualIKJ_double/128                      581 us          566 us         1252 FLOP/s=7.40844G/s bytes/s=662.366M/s
+BM_Square/ManualIKJ_double/256                     4742 us         4602 us          151 FLOP/s=7.29105G/s bytes/s=325.935M/s
+BM_Square/ManualIKJ_double/512                    44496 us        43266 us           16 FLOP/s=6.20424G/s bytes/s=138.675M/s
+BM_Square/ManualIKJ_double/1024                  423949 us       411745 us            2 FLOP/s=5.21557G/s bytes/s=58.2885M/s
+BM_Square/Eigen_half/64                            3525 us         3475 us          199 FLOP/s=150.872M/s bytes/s=6.74448M/s
+BM_Square/Eigen_half/128                          26776 us        25892 us           27 FLOP/s=161.989M/s bytes/s=3.62074M/s
+BM_Square/Eigen_half/256                         218783 us       211465 us            3 FLOP/s=158.676M/s bytes/s=1.77334M/s
+BM_Square/Eigen_half/512                        1688511 us      1652413 us            1 FLOP/s=162.451M/s bytes/s=929.55k/s
+BM_Square/ManualIKJ_half/64                        3660 us         3623 us          196 FLOP/s=144.695M/s bytes/s=6.46837M/s
+BM_Square/ManualIKJ_half/128                      28368 us        28207 us           25 FLOP/s=148.698M/s bytes/s=3.32366M/s
+BM_Square/ManualIKJ_half/256                     226828 us       224044 us            3 FLOP/s=149.767M/s bytes/s=1.67378M/s
+BM_Square/ManualIKJ_half/512                    1764710 us      1747393 us            1 FLOP/s=153.621M/s bytes/s=879.024k/s
+BM_Transposed/Eigen_float/128/0                    44.2 us         44.0 us        15772 FLOP/s=95.2233G/s bytes/s=4.15704G/s
+BM_Transposed/Eigen_float/128/1                    49.0 us         48.6 us        14475 FLOP/s=86.2942G/s bytes/s=3.76724G/s
+BM_Transposed/Eigen_float/128/2                    45.8 us         45.4 us        15629 FLOP/s=92.4071G/s bytes/s=4.0341G/s
+BM_Transposed/Eigen_float/128/3                    49.4 us         49.1 us        14054 FLOP/s=85.4844G/s bytes/s=3.73189G/s
+BM_Transposed/Eigen_float/1024/0                  24957 us        24269 us           29 FLOP/s=88.4882G/s bytes/s=494.466M/s
+BM_Transposed/Eigen_float/1024/1                  25430 us        24887 us           28 FLOP/s=86.2885G/s bytes/s=482.175M/s
+BM_Transposed/Eigen_float/1024/2                  23940 us        23742 us           30 FLOP/s=90.4507G/s bytes/s=505.433M/s
+BM_Transposed/Eigen_float/1024/3                  25416 us        24967 us           28 FLOP/s=86.0125G/s bytes/s=480.632M/s
+BM_Transposed/Eigen_double/128/0                   93.8 us         93.1 us         7535 FLOP/s=45.0523G/s bytes/s=3.93359G/s
+BM_Transposed/Eigen_double/128/1                    100 us         99.5 us         7061 FLOP/s=42.1333G/s bytes/s=3.67872G/s
+BM_Transposed/Eigen_double/128/2                   97.7 us         94.2 us         7507 FLOP/s=44.5122G/s bytes/s=3.88643G/s
+BM_Transposed/Eigen_double/128/3                   99.0 us         96.9 us         6981 FLOP/s=43.2682G/s bytes/s=3.77781G/s
+BM_Transposed/Eigen_double/1024/0                 52695 us        51041 us           13 FLOP/s=42.0739G/s bytes/s=470.212M/s
+BM_Transposed/Eigen_double/1024/1                 58082 us        55620 us           13 FLOP/s=38.61G/s bytes/s=431.501M/s
+BM_Transposed/Eigen_double/1024/2                 53207 us        50670 us           13 FLOP/s=42.3817G/s bytes/s=473.652M/s
+BM_Transposed/Eigen_double/1024/3                 53947 us        52430 us           13 FLOP/s=40.9593G/s bytes/s=457.756M/s
+BM_TallSkinny/Eigen_float/65536/32/32              2432 us         2414 us          284 FLOP/s=55.6029G/s bytes/s=6.47461G/s
+BM_TallSkinny/Eigen_float/65536/128/128           37544 us        36720 us           19 FLOP/s=58.4822G/s bytes/s=1.70372G/s
+BM_TallSkinny/Eigen_float/32/32/65536              2544 us         2307 us          300 FLOP/s=58.1746G/s bytes/s=6.77407G/s
+BM_TallSkinny/ManualIKJ_float/65536/32/32         12764 us        12557 us           55 FLOP/s=10.6887G/s bytes/s=1.24463G/s
+BM_TallSkinny/ManualIKJ_float/65536/128/128      123578 us       121859 us            6 FLOP/s=17.6227G/s bytes/s=525.711M/s
+BM_TallSkinny/ManualIKJ_float/32/32/65536         16717 us        16537 us           42 FLOP/s=8.11597G/s bytes/s=967.735M/s
+BM_TallSkinny/Sgemm_float/65536/32/32              2659 us         2629 us          267 FLOP/s=51.0596G/s bytes/s=5.94557G/s
+BM_TallSkinny/Sgemm_float/65536/128/128           35255 us        34781 us           20 FLOP/s=61.7422G/s bytes/s=1.79869G/s
+BM_TallSkinny/Sgemm_float/32/32/65536              4496 us         4008 us          188 FLOP/s=33.4886G/s bytes/s=3.89954G/s
+BM_TallSkinny/Eigen_double/65536/32/32             6605 us         6128 us           99 FLOP/s=21.9042G/s bytes/s=5.1012G/s
+BM_TallSkinny/Eigen_double/65536/128/128          69452 us        68546 us            9 FLOP/s=31.3289G/s bytes/s=1.82536G/s
+BM_TallSkinny/Eigen_double/32/32/65536             6641 us         6491 us          109 FLOP/s=20.6772G/s bytes/s=4.81546G/s
+BM_TallSkinny/Eigen_half/65536/32/32             755067 us       727955 us            1 FLOP/s=184.376M/s bytes/s=10.9924M/s
+BM_TallSkinny/Eigen_half/65536/128/128         12795003 us     12433022 us            1 FLOP/s=172.724M/s bytes/s=2.5763M/s
+BM_TallSkinny/Eigen_half/32/32/65536             768969 us       739666 us            1 FLOP/s=181.457M/s bytes/s=10.8183M/s
+BM_Batched/Eigen_float/4/65536                     3580 us         3238 us          193 FLOP/s=2.59068G/s bytes/s=3.61913G/s
+BM_Batched/Eigen_float/8/16384                     4501 us         3388 us          218 FLOP/s=4.95238G/s bytes/s=3.45919G/s
+BM_Batched/Eigen_float/16/4096                     1565 us         1430 us          454 FLOP/s=23.4708G/s bytes/s=8.19708G/s
+BM_Batched/Eigen_float/32/1024                     1536 us         1474 us          479 FLOP/s=45.5308G/s bytes/s=7.95072G/s
+BM_Batched/Eigen_float/64/256                      2637 us         2127 us          339 FLOP/s=63.114G/s bytes/s=5.51058G/s
+BM_Batched/ManualIKJ_float/4/65536                 7606 us         7417 us           93 FLOP/s=1.13092G/s bytes/s=1.57988G/s
+BM_Batched/ManualIKJ_float/8/16384                 7356 us         7022 us           91 FLOP/s=2.38927G/s bytes/s=1.66888G/s
+BM_Batched/ManualIKJ_float/16/4096                 5456 us         5263 us          129 FLOP/s=6.37585G/s bytes/s=2.22674G/s
+BM_Batched/ManualIKJ_float/32/1024                 6955 us         6624 us          103 FLOP/s=10.1306G/s bytes/s=1.76904G/s
+BM_Batched/ManualIKJ_float/64/256                  9406 us         9111 us           76 FLOP/s=14.7309G/s bytes/s=1.28618G/s
+BM_Batched/Sgemm_float/4/65536                    11193 us        10914 us           67 FLOP/s=768.586M/s bytes/s=1099.47M/s
+BM_Batched/Sgemm_float/8/16384                     4574 us         4491 us          148 FLOP/s=3.73604G/s bytes/s=2.6096G/s
+BM_Batched/Sgemm_float/16/4096                     2632 us         2556 us          264 FLOP/s=13.1284G/s bytes/s=4.58505G/s
+BM_Batched/Sgemm_float/32/1024                     1989 us         1936 us          338 FLOP/s=34.6662G/s bytes/s=6.05352G/s
+BM_Batched/Sgemm_float/64/256                      2462 us         2373 us          277 FLOP/s=56.5624G/s bytes/s=4.93855G/s
+BM_Batched/Eigen_double/4/65536                    8131 us         7862 us          100 FLOP/s=1066.93M/s bytes/s=2.98098G/s
+BM_Batched/Eigen_double/8/16384                    2818 us         2740 us          253 FLOP/s=6.12394G/s bytes/s=8.55505G/s
+BM_Batched/Eigen_double/16/4096                    2453 us         2379 us          263 FLOP/s=14.1017G/s bytes/s=9.84989G/s
+BM_Batched/Eigen_double/32/1024                    2759 us         2706 us          263 FLOP/s=24.7955G/s bytes/s=8.65972G/s
+BM_Batched/Eigen_double/64/256                     4173 us         4074 us          168 FLOP/s=32.9434G/s bytes/s=5.75267G/s
+BM_Batched/Eigen_half/4/65536                     58157 us        56117 us           12 FLOP/s=149.485M/s bytes/s=106.92M/s
+BM_Batched/Eigen_half/8/16384                    131360 us       127800 us            6 FLOP/s=131.277M/s bytes/s=46.9485M/s
+BM_Batched/Eigen_half/16/4096                    269294 us       263115 us            3 FLOP/s=127.528M/s bytes/s=22.8038M/s
+BM_Batched/Eigen_half/32/1024                    439064 us       424102 us            2 FLOP/s=158.238M/s bytes/s=14.1475M/s
+BM_Batched/Eigen_half/64/256                     874391 us       856328 us            1 FLOP/s=156.736M/s bytes/s=7.00666M/s
 
 */
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+#include "../algorithm/ThreadPool.hpp"
+
+// Single precision GEMM, C = A B for row-major A (m x k), B (k x n) and C (m x n) with row strides
+// `lda`, `ldb` and `ldc`, blocked like BLIS and OpenBLAS:
+// - B is cut into blocks of `sgemm_kc` rows by `sgemm_nc` columns, which stay in L3, and A into
+//   blocks of `sgemm_mc` rows by `sgemm_kc` columns, which stay in L2.
+// - Each block is packed into panels of `sgemm_nr` columns of B or `sgemm_mr` rows of A, stored
+//   in the order the micro-kernel reads them, so it reads both contiguously. Panels at the edges
+//   are padded with zeros.
+// - The micro-kernel keeps an `sgemm_mr` x `sgemm_nr` tile of C in registers, two vectors per row,
+//   and for each of the `sgemm_kc` steps loads one row of the B panel, which stays in L1, and
+//   broadcasts one column of the A panel into `sgemm_mr` rows of two FMAs.
+// The tile is 6 x 16 with AVX2 and FMA, 12 registers of 16. With AVX-512, which has twice the
+// registers, twice as wide, it's 12 x 32.
+#if defined(__AVX512F__)
+using SgemmVector = __m512;
+constexpr int sgemm_mr = 12;
+constexpr int sgemm_nr = 32;
+inline __m512 SgemmZero() {
+    return _mm512_setzero_ps();
+}
+inline __m512 SgemmLoad(const float *p) {
+    return _mm512_loadu_ps(p);
+}
+inline void SgemmStore(float *p, __m512 x) {
+    _mm512_storeu_ps(p, x);
+}
+inline __m512 SgemmBroadcast(const float *p) {
+    return _mm512_set1_ps(*p);
+}
+inline __m512 SgemmAdd(__m512 a, __m512 b) {
+    return _mm512_add_ps(a, b);
+}
+inline __m512 SgemmFMA(__m512 a, __m512 b, __m512 c) {
+    return _mm512_fmadd_ps(a, b, c);
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+using SgemmVector = __m256;
+constexpr int sgemm_mr = 6;
+constexpr int sgemm_nr = 16;
+inline __m256 SgemmZero() {
+    return _mm256_setzero_ps();
+}
+inline __m256 SgemmLoad(const float *p) {
+    return _mm256_loadu_ps(p);
+}
+inline void SgemmStore(float *p, __m256 x) {
+    _mm256_storeu_ps(p, x);
+}
+inline __m256 SgemmBroadcast(const float *p) {
+    return _mm256_broadcast_ss(p);
+}
+inline __m256 SgemmAdd(__m256 a, __m256 b) {
+    return _mm256_add_ps(a, b);
+}
+inline __m256 SgemmFMA(__m256 a, __m256 b, __m256 c) {
+    return _mm256_fmadd_ps(a, b, c);
+}
+#else
+constexpr int sgemm_mr = 6;
+constexpr int sgemm_nr = 16;
+#endif
+constexpr int sgemm_kc = 256;
+constexpr int sgemm_mc = 144;
+constexpr int sgemm_nc = 3072;
+
+// C tile (`ldc`) = or += the product of an A panel and a B panel, both `kc` deep.
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+inline void SgemmMicroKernel(int kc, const float *a, const float *b, float *c, size_t ldc,
+                             bool accumulate) {
+    constexpr int lanes = sgemm_nr / 2;
+    SgemmVector t[sgemm_mr][2];
+    for(int r = 0; r < sgemm_mr; r++)
+        t[r][0] = t[r][1] = SgemmZero();
+    for(int p = 0; p < kc; p++, a += sgemm_mr, b += sgemm_nr) {
+        SgemmVector b0 = SgemmLoad(b), b1 = SgemmLoad(b + lanes);
+        for(int r = 0; r < sgemm_mr; r++) {
+            SgemmVector ar = SgemmBroadcast(a + r);
+            t[r][0] = SgemmFMA(ar, b0, t[r][0]);
+            t[r][1] = SgemmFMA(ar, b1, t[r][1]);
+        }
+    }
+    for(int r = 0; r < sgemm_mr; r++, c += ldc) {
+        if(accumulate) {
+            t[r][0] = SgemmAdd(t[r][0], SgemmLoad(c));
+            t[r][1] = SgemmAdd(t[r][1], SgemmLoad(c + lanes));
+        }
+        SgemmStore(c, t[r][0]);
+        SgemmStore(c + lanes, t[r][1]);
+    }
+}
+#else
+// Portable, for the compiler to vectorize.
+inline void SgemmMicroKernel(int kc, const float *a, const float *b, float *c, size_t ldc,
+                             bool accumulate) {
+    float t[sgemm_mr][sgemm_nr] = {};
+    for(int p = 0; p < kc; p++, a += sgemm_mr, b += sgemm_nr)
+        for(int r = 0; r < sgemm_mr; r++)
+            for(int j = 0; j < sgemm_nr; j++)
+                t[r][j] += a[r] * b[j];
+    for(int r = 0; r < sgemm_mr; r++, c += ldc)
+        for(int j = 0; j < sgemm_nr; j++)
+            c[j] = accumulate ? c[j] + t[r][j] : t[r][j];
+}
+#endif
+
+// Pack rows [0, mc) and columns [0, kc) of `a` into panels of `sgemm_mr` rows, column by column.
+inline void SgemmPackA(int mc, int kc, const float *a, size_t lda, float *packed) {
+    for(int i = 0; i < mc; i += sgemm_mr) {
+        int mr = min(sgemm_mr, mc - i);
+        for(int p = 0; p < kc; p++, packed += sgemm_mr) {
+            for(int r = 0; r < mr; r++)
+                packed[r] = a[(i + r) * lda + p];
+            fill(packed + mr, packed + sgemm_mr, 0.0f);
+        }
+    }
+}
+
+// Pack columns [j, j + `sgemm_nr`) of rows [0, kc) of `b` into a panel, row by row.
+inline void SgemmPackB(int nc, int kc, int j, const float *b, size_t ldb, float *packed) {
+    int nr = min(sgemm_nr, nc - j);
+    for(int p = 0; p < kc; p++, packed += sgemm_nr) {
+        copy(b + p * ldb + j, b + p * ldb + j + nr, packed);
+        fill(packed + nr, packed + sgemm_nr, 0.0f);
+    }
+}
+
+// Multiply a packed A block by a packed B block into C. Tiles at the edges of C go through a
+// buffer, as the micro-kernel always writes a whole tile.
+inline void SgemmMacroKernel(int mc, int nc, int kc, const float *a, const float *b, float *c,
+                             size_t ldc, bool accumulate) {
+    float edge[sgemm_mr * sgemm_nr];
+    for(int j = 0; j < nc; j += sgemm_nr)
+        for(int i = 0; i < mc; i += sgemm_mr) {
+            int mr = min(sgemm_mr, mc - i), nr = min(sgemm_nr, nc - j);
+            const float *a_panel = a + i * kc, *b_panel = b + j * kc;
+            float *c_tile = c + i * ldc + j;
+            if(mr == sgemm_mr && nr == sgemm_nr) {
+                SgemmMicroKernel(kc, a_panel, b_panel, c_tile, ldc, accumulate);
+                continue;
+            }
+            SgemmMicroKernel(kc, a_panel, b_panel, edge, sgemm_nr, false);
+            for(int r = 0; r < mr; r++)
+                for(int s = 0; s < nr; s++) {
+                    float &x = c_tile[r * ldc + s];
+                    x = accumulate ? x + edge[r * sgemm_nr + s] : edge[r * sgemm_nr + s];
+                }
+        }
+}
+
+// The loops over blocks, for `threads` threads, with `for_each(count, f)` calling `f(i)` for each
+// i in [0, count). The blocks of rows of A, and so of C, are split among the threads, each packing
+// its own A block, after the B block they share is packed in parallel. Blocks are smaller than
+// `sgemm_mc` when there are fewer rows than threads times `sgemm_mc`.
+// The packing buffers are kept by each thread, since small products are dominated by allocations.
+template<typename ForEach>
+void SgemmBlocks(int m, int n, int k, const float *a, size_t lda, const float *b, size_t ldb,
+                 float *c, size_t ldc, int threads, ForEach for_each) {
+    if(k == 0) {
+        for(int i = 0; i < m; i++)
+            fill(c + i * ldc, c + i * ldc + n, 0.0f);
+        return;
+    }
+    int mc = (m + threads - 1) / threads;
+    mc = min(sgemm_mc, max(sgemm_mr, (mc + sgemm_mr - 1) / sgemm_mr * sgemm_mr));
+    int m_blocks = (m + mc - 1) / mc;
+    thread_local vector<float> packed_b;
+    packed_b.resize(size_t(sgemm_kc) * ((min(n, sgemm_nc) + sgemm_nr - 1) / sgemm_nr) * sgemm_nr);
+    float *b_panels = packed_b.data();
+    for(int jc = 0; jc < n; jc += sgemm_nc) {
+        int nc = min(sgemm_nc, n - jc);
+        for(int pc = 0; pc < k; pc += sgemm_kc) {
+            int kc = min(sgemm_kc, k - pc);
+            const float *b_block = b + pc * ldb + jc;
+            for_each((nc + sgemm_nr - 1) / sgemm_nr, [&](int jr) {
+                SgemmPackB(nc, kc, jr * sgemm_nr, b_block, ldb, b_panels + jr * sgemm_nr * kc);
+            });
+            for_each(m_blocks, [&](int block) {
+                thread_local vector<float> packed_a(sgemm_mc * sgemm_kc);
+                int ic = block * mc, rows = min(mc, m - ic);
+                SgemmPackA(rows, kc, a + ic * lda + pc, lda, packed_a.data());
+                SgemmMacroKernel(rows, nc, kc, packed_a.data(), b_panels, c + ic * ldc + jc, ldc,
+                                 pc > 0);
+            });
+        }
+    }
+}
+
+inline void Sgemm(int m, int n, int k, const float *a, size_t lda, const float *b, size_t ldb,
+                  float *c, size_t ldc) {
+    SgemmBlocks(m, n, k, a, lda, b, ldb, c, ldc, 1, [](int count, auto f) {
+        for(int i = 0; i < count; i++)
+            f(i);
+    });
+}
+
+// `Sgemm()` on `pool`.
+inline void ParallelSgemm(int m, int n, int k, const float *a, size_t lda, const float *b,
+                          size_t ldb, float *c, size_t ldc, ThreadPool &pool) {
+    SgemmBlocks(m, n, k, a, lda, b, ldb, c, ldc, pool.size() + 1, [&](int count, auto f) {
+        pool.ParallelFor(count, f);
+    });
+}